@@ -7,11 +7,12 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 #pragma once
 
 #include "reed_solomon_error_correction.hh"
+#include "parallel.hh"
 #include "bitman.hh"
 
 namespace CODE {
 
-template <int ROOTS, int FCR, int MSG, typename GF>
+template <int ROOTS, int FCR, int MSG, typename GF, template <int, typename> class KES = RS::BerlekampMassey>
 class BoseChaudhuriHocquenghemDecoder
 {
 public:
@@ -20,29 +21,101 @@ public:
 	typedef typename GF::IndexType IndexType;
 	static const int NR = ROOTS;
 	static const int N = GF::N, K = MSG, NP = N - K;
+	static const int W = (NP+63)/64;
 private:
-	ReedSolomonErrorCorrection<NR, FCR, GF> algorithm;
-	void update_syndromes(const uint8_t *poly, ValueType *syndromes, int begin, int end)
+	ReedSolomonErrorCorrection<NR, FCR, GF, KES> algorithm;
+	// generator without its leading term, $x^{NP-1}$ coefficient in the top bit
+	uint64_t generator[W];
+	// $table_i = (i(x) * x^{NP}) \mod{generator}$
+	uint64_t table[256][W];
+	void update(uint64_t *reg, bool data)
 	{
-		for (int j = begin; j < end; ++j) {
-			ValueType coeff(get_be_bit(poly, j));
-			IndexType root(FCR), pe(1);
-			for (int i = 0; i < NR; ++i) {
-				syndromes[i] = fma(root, syndromes[i], coeff);
-				root *= pe;
-			}
+		uint64_t feedback = -uint64_t(data != (reg[0] >> 63));
+		for (int w = 0; w < W-1; ++w)
+			reg[w] = ((reg[w] << 1) | (reg[w+1] >> 63)) ^ (generator[w] & feedback);
+		reg[W-1] = (reg[W-1] << 1) ^ (generator[W-1] & feedback);
+	}
+	bool remainder(const uint8_t *data, const uint8_t *parity, uint64_t *reg, int data_len)
+	{
+		// $remainder = code \mod{generator}$
+		for (int w = 0; w < W; ++w)
+			reg[w] = 0;
+		int bytes = NP < 8 ? 0 : data_len / 8;
+		for (int i = 0; i < bytes; ++i) {
+			int fb = data[i] ^ (reg[0] >> 56);
+			for (int w = 0; w < W-1; ++w)
+				reg[w] = ((reg[w] << 8) | (reg[w+1] >> 56)) ^ table[fb][w];
+			reg[W-1] = (reg[W-1] << 8) ^ table[fb][W-1];
 		}
+		for (int i = 8 * bytes; i < data_len; ++i)
+			update(reg, get_be_bit(data, i));
+		for (int l = 0; l < NP/8; ++l)
+			reg[l/8] ^= uint64_t(parity[l]) << (56-8*(l%8));
+		if (NP % 8)
+			reg[NP/64] ^= uint64_t(parity[NP/8] & (255 << (8-NP%8))) << (56-8*((NP/8)%8));
+		uint64_t nonzero = 0;
+		for (int w = 0; w < W; ++w)
+			nonzero |= reg[w];
+		return nonzero;
 	}
 public:
+	BoseChaudhuriHocquenghemDecoder()
+	{
+		// $generator(x) = \prod_j(x - pe^j)$ over the cyclotomic cosets of the roots
+		bool *root = new bool[N];
+		for (int j = 0; j < N; ++j)
+			root[j] = false;
+		for (int i = 0; i < NR; ++i)
+			for (int j = (FCR + i) % N; !root[j]; j = (2 * j) % N)
+				root[j] = true;
+		ValueType poly[NP+1];
+		poly[0] = ValueType(1);
+		int degree = 0;
+		for (int j = 0; j < N; ++j) {
+			if (!root[j])
+				continue;
+			assert(degree < NP);
+			IndexType tmp(j);
+			poly[++degree] = ValueType(0);
+			for (int i = degree; i > 0; --i)
+				poly[i] = fma(tmp, poly[i], poly[i-1]);
+			poly[0] *= tmp;
+		}
+		delete[] root;
+		assert(degree == NP);
+		for (int w = 0; w < W; ++w)
+			generator[w] = 0;
+		for (int i = 0; i < NP; ++i) {
+			assert((int)poly[NP-1-i] <= 1);
+			generator[i/64] |= uint64_t((int)poly[NP-1-i]) << (63-i%64);
+		}
+		for (int i = 0; i < 256; ++i) {
+			for (int w = 0; w < W; ++w)
+				table[i][w] = 0;
+			for (int j = 0; j < 8; ++j)
+				update(table[i], (i>>(7-j))&1);
+		}
+	}
 	int compute_syndromes(const uint8_t *data, const uint8_t *parity, ValueType *syndromes, int data_len = K)
 	{
 		assert(0 < data_len && data_len <= K);
-		// $syndromes_i = code(pe^{FCR+i})$
-		ValueType coeff(get_be_bit(data, 0));
+		uint64_t reg[W];
+		if (!remainder(data, parity, reg, data_len)) {
+			for (int i = 0; i < NR; ++i)
+				syndromes[i] = ValueType(0);
+			return 0;
+		}
+		// $syndromes_i = code(pe^{FCR+i}) = remainder(pe^{FCR+i})$
 		for (int i = 0; i < NR; ++i)
-			syndromes[i] = coeff;
-		update_syndromes(data, syndromes, 1, data_len);
-		update_syndromes(parity, syndromes, 0, NP);
+			syndromes[i] = ValueType(0);
+		for (int j = 0; j < NP; ++j) {
+			ValueType coeff((reg[j/64] >> (63-j%64)) & 1);
+			IndexType root(FCR), pe(1);
+			for (int i = 0; i < NR; ++i) {
+				syndromes[i] = fma(root, syndromes[i], coeff);
+				root *= pe;
+			}
+		}
 		int nonzero = 0;
 		for (int i = 0; i < NR; ++i)
 			nonzero += !!syndromes[i];
@@ -74,7 +147,7 @@ public:
 			return 0;
 		IndexType locations[NR];
 		ValueType magnitudes[NR];
-		int count = algorithm(syndromes, locations, magnitudes, reinterpret_cast<IndexType *>(erasures), erasures_count);
+		int count = algorithm(syndromes, locations, magnitudes, reinterpret_cast<IndexType *>(erasures), erasures_count, data_len + NP);
 		if (count <= 0)
 			return count;
 		for (int i = 0; i < count; ++i)
@@ -96,6 +169,33 @@ public:
 			corrections_count += !!magnitudes[i];
 		return corrections_count;
 	}
+	int batch(uint8_t *data, uint8_t *parity, int blocks, int *results = 0, int data_len = K, int threads = 1)
+	{
+		// $blocks$ codewords stored back to back, returns the number of uncorrectable ones
+		assert(0 < data_len && data_len <= K);
+		int data_bytes = (data_len + 7) / 8, parity_bytes = (NP + 7) / 8;
+		std::vector<int> dirty;
+		for (int b = 0; b < blocks; ++b) {
+			uint64_t reg[W];
+			if (remainder(data + b * data_bytes, parity + b * parity_bytes, reg, data_len))
+				dirty.push_back(b);
+			else if (results)
+				results[b] = 0;
+		}
+		// the threads share the decoder, which only reads its tables while decoding
+		std::vector<int> status(dirty.size());
+		parallel_for((int)dirty.size(), threads, [&](int i) {
+			int b = dirty[i];
+			status[i] = (*this)(data + b * data_bytes, parity + b * parity_bytes, 0, 0, data_len);
+		});
+		int failures = 0;
+		for (size_t i = 0; i < dirty.size(); ++i) {
+			failures += status[i] < 0;
+			if (results)
+				results[dirty[i]] = status[i];
+		}
+		return failures;
+	}
 };
 
 template <int ROOTS, int FCR, int MSG, typename GF>
@@ -157,7 +257,7 @@ public:
 			return 0;
 		IndexType locations[NR];
 		ValueType magnitudes[NR];
-		int count = algorithm(syndromes, locations, magnitudes, erasures, erasures_count);
+		int count = algorithm(syndromes, locations, magnitudes, erasures, erasures_count, data_len + NP);
 		if (count <= 0)
 			return count;
 		for (int i = 0; i < count; ++i)
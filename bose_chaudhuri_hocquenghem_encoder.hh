@@ -17,12 +17,22 @@ class BoseChaudhuriHocquenghemEncoder
 public:
 	static const int N = LEN, K = MSG, NP = N - K;
 	static const int G = ((NP+1)+7)/8;
+	static const int W = (NP+63)/64;
 private:
 	uint8_t generator[G];
+	// $table_i = (i(x) * x^{NP}) \mod{generator}$
+	uint64_t table[256][W];
 	static constexpr uint8_t slb1(uint8_t *buf, int pos)
 	{
 		return (buf[pos]<<1) | (buf[pos+1]>>7);
 	}
+	void update(uint8_t *parity, bool data)
+	{
+		uint8_t feedback = -(data != get_be_bit(parity, 0));
+		for (int l = 0; l < (NP-1)/8; ++l)
+			parity[l] = (generator[l] & feedback) ^ slb1(parity, l);
+		parity[(NP-1)/8] = (generator[(NP-1)/8] & feedback) ^ (parity[(NP-1)/8]<<1);
+	}
 public:
 	BoseChaudhuriHocquenghemEncoder(std::initializer_list<int> minimal_polynomials)
 	{
@@ -57,24 +67,37 @@ public:
 		for (int i = 0; i < NP; ++i)
 			set_be_bit(generator, i, get_be_bit(generator, i+1));
 		set_be_bit(generator, NP, 0);
+		for (int i = 0; i < 256; ++i) {
+			uint8_t tmp[8*W];
+			for (int l = 0; l < 8*W; ++l)
+				tmp[l] = 0;
+			for (int j = 0; j < 8; ++j)
+				update(tmp, (i>>(7-j))&1);
+			for (int w = 0; w < W; ++w) {
+				table[i][w] = 0;
+				for (int l = 0; l < 8; ++l)
+					table[i][w] |= uint64_t(tmp[8*w+l]) << (56-8*l);
+			}
+		}
 	}
 	void operator()(const uint8_t *data, uint8_t *parity, int data_len = K)
 	{
 		assert(0 < data_len && data_len <= K);
 		// $code = data * x^{NP} + (data * x^{NP}) \mod{generator}$
-		for (int l = 0; l <= (NP-1)/8; ++l)
-			parity[l] = 0;
-		for (int i = 0; i < data_len; ++i) {
-			if (get_be_bit(data, i) != get_be_bit(parity, 0)) {
-				for (int l = 0; l < (NP-1)/8; ++l)
-					parity[l] = generator[l] ^ slb1(parity, l);
-				parity[(NP-1)/8] = generator[(NP-1)/8] ^ (parity[(NP-1)/8]<<1);
-			} else {
-				for (int l = 0; l < (NP-1)/8; ++l)
-					parity[l] = slb1(parity, l);
-				parity[(NP-1)/8] <<= 1;
-			}
+		uint64_t reg[W];
+		for (int w = 0; w < W; ++w)
+			reg[w] = 0;
+		int bytes = NP < 8 ? 0 : data_len / 8;
+		for (int i = 0; i < bytes; ++i) {
+			int fb = data[i] ^ (reg[0] >> 56);
+			for (int w = 0; w < W-1; ++w)
+				reg[w] = ((reg[w] << 8) | (reg[w+1] >> 56)) ^ table[fb][w];
+			reg[W-1] = (reg[W-1] << 8) ^ table[fb][W-1];
 		}
+		for (int l = 0; l <= (NP-1)/8; ++l)
+			parity[l] = reg[l/8] >> (56-8*(l%8));
+		for (int i = 8 * bytes; i < data_len; ++i)
+			update(parity, get_be_bit(data, i));
 	}
 };
 
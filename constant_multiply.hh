@@ -0,0 +1,229 @@
+/*
+Multiplication of Galois field elements by a constant
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#else
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
+#endif
+
+namespace CODE {
+
+template <typename GF>
+class ConstantMultiply
+{
+public:
+	typedef typename GF::value_type value_type;
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	static_assert(sizeof(value_type) == 1 || sizeof(value_type) == 2, "only 8 and 16 bit elements supported");
+	static const int S = sizeof(value_type);
+#ifdef __AVX2__
+	static const int SIMD = 32;
+#else
+	static const int SIMD = 16;
+#endif
+private:
+	// $b \cdot a = \sum_n b \cdot (a_n \ll 4n)$ for the nibbles $a_n$ of $a$
+	alignas(16) uint8_t lut[2*S][S][16];
+#if defined(__ARM_NEON) && !defined(__aarch64__)
+	static inline uint8x16_t vqtbl1q_u8(uint8x16_t lut, uint8x16_t idx)
+	{
+		uint8x8x2_t l82 = {{ vget_low_u8(lut), vget_high_u8(lut) }};
+		uint8x8_t lo = vtbl2_u8(l82, vget_low_u8(idx));
+		uint8x8_t hi = vtbl2_u8(l82, vget_high_u8(idx));
+		return vcombine_u8(lo, hi);
+	}
+#endif
+#if defined(__ARM_NEON) || defined(__AVX2__) || defined(__SSE4_1__)
+	__attribute__((flatten))
+	void simd(uint8_t *c, const uint8_t *a, int size, bool init) const
+	{
+#ifdef __ARM_NEON
+		uint8x16_t l16 = vld1q_u8(lut[0][0]);
+		uint8x16_t h16 = vld1q_u8(lut[1][0]);
+		for (int i = 0; i < size; i += 16, a += 16, c += 16) {
+			uint8x16_t a16 = vld1q_u8(reinterpret_cast<const uint8_t *>(__builtin_assume_aligned(a, 16)));
+			uint8x16_t aln = vandq_u8(a16, vdupq_n_u8(15));
+			uint8x16_t ahn = vshrq_n_u8(a16, 4);
+			uint8x16_t c16 = veorq_u8(vqtbl1q_u8(l16, aln), vqtbl1q_u8(h16, ahn));
+			if (!init)
+				c16 = veorq_u8(c16, vld1q_u8(reinterpret_cast<const uint8_t *>(__builtin_assume_aligned(c, 16))));
+			vst1q_u8(reinterpret_cast<uint8_t *>(__builtin_assume_aligned(c, 16)), c16);
+		}
+#else
+#ifdef __AVX2__
+		__m256i l162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][0])));
+		__m256i h162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][0])));
+		for (int i = 0; i < size; i += 32, a += 32, c += 32) {
+			__m256i a32 = _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(a, 32)));
+			__m256i aln = _mm256_and_si256(a32, _mm256_set1_epi8(15));
+			__m256i ahn = _mm256_and_si256(_mm256_srli_epi16(a32, 4), _mm256_set1_epi8(15));
+			__m256i c32 = _mm256_xor_si256(_mm256_shuffle_epi8(l162, aln), _mm256_shuffle_epi8(h162, ahn));
+			if (!init)
+				c32 = _mm256_xor_si256(c32, _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(c, 32))));
+			_mm256_store_si256(reinterpret_cast<__m256i *>(__builtin_assume_aligned(c, 32)), c32);
+		}
+#else
+		__m128i l16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][0]));
+		__m128i h16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][0]));
+		for (int i = 0; i < size; i += 16, a += 16, c += 16) {
+			__m128i a16 = _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(a, 16)));
+			__m128i aln = _mm_and_si128(a16, _mm_set1_epi8(15));
+			__m128i ahn = _mm_and_si128(_mm_srli_epi16(a16, 4), _mm_set1_epi8(15));
+			__m128i c16 = _mm_xor_si128(_mm_shuffle_epi8(l16, aln), _mm_shuffle_epi8(h16, ahn));
+			if (!init)
+				c16 = _mm_xor_si128(c16, _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(c, 16))));
+			_mm_store_si128(reinterpret_cast<__m128i *>(__builtin_assume_aligned(c, 16)), c16);
+		}
+#endif
+#endif
+	}
+	__attribute__((flatten))
+	void simd(uint16_t *c, const uint16_t *a, int size, bool init) const
+	{
+#ifdef __ARM_NEON
+		uint8x16_t lll16 = vld1q_u8(lut[0][0]), hll16 = vld1q_u8(lut[0][1]);
+		uint8x16_t llh16 = vld1q_u8(lut[1][0]), hlh16 = vld1q_u8(lut[1][1]);
+		uint8x16_t lhl16 = vld1q_u8(lut[2][0]), hhl16 = vld1q_u8(lut[2][1]);
+		uint8x16_t lhh16 = vld1q_u8(lut[3][0]), hhh16 = vld1q_u8(lut[3][1]);
+		for (int i = 0; i < size; i += 16, a += 16, c += 16) {
+			uint16x8_t al8 = vld1q_u16(reinterpret_cast<const uint16_t *>(__builtin_assume_aligned(a, 16)));
+			uint16x8_t ah8 = vld1q_u16(reinterpret_cast<const uint16_t *>(__builtin_assume_aligned(a+8, 16)));
+			uint8x16_t al16 = (uint8x16_t)vorrq_u16(vshlq_n_u16(ah8, 8), vandq_u16(al8, vdupq_n_u16(255)));
+			uint8x16_t ah16 = (uint8x16_t)vorrq_u16(vandq_u16(ah8, vdupq_n_u16(0xff00)), vshrq_n_u16(al8, 8));
+			uint8x16_t alln = vandq_u8(al16, vdupq_n_u8(15));
+			uint8x16_t alhn = vshrq_n_u8(al16, 4);
+			uint8x16_t ahln = vandq_u8(ah16, vdupq_n_u8(15));
+			uint8x16_t ahhn = vshrq_n_u8(ah16, 4);
+			uint16x8_t cl16 = (uint16x8_t)veorq_u8(veorq_u8(vqtbl1q_u8(lll16, alln), vqtbl1q_u8(llh16, alhn)), veorq_u8(vqtbl1q_u8(lhl16, ahln), vqtbl1q_u8(lhh16, ahhn)));
+			uint16x8_t ch16 = (uint16x8_t)veorq_u8(veorq_u8(vqtbl1q_u8(hll16, alln), vqtbl1q_u8(hlh16, alhn)), veorq_u8(vqtbl1q_u8(hhl16, ahln), vqtbl1q_u8(hhh16, ahhn)));
+			uint16x8_t cl8 = vorrq_u16(vshlq_n_u16(ch16, 8), vandq_u16(cl16, vdupq_n_u16(255)));
+			uint16x8_t ch8 = vorrq_u16(vandq_u16(ch16, vdupq_n_u16(0xff00)), vshrq_n_u16(cl16, 8));
+			if (!init) {
+				cl8 = veorq_u16(cl8, vld1q_u16(reinterpret_cast<const uint16_t *>(__builtin_assume_aligned(c, 16))));
+				ch8 = veorq_u16(ch8, vld1q_u16(reinterpret_cast<const uint16_t *>(__builtin_assume_aligned(c+8, 16))));
+			}
+			vst1q_u16(reinterpret_cast<uint16_t *>(__builtin_assume_aligned(c, 16)), cl8);
+			vst1q_u16(reinterpret_cast<uint16_t *>(__builtin_assume_aligned(c+8, 16)), ch8);
+		}
+#else
+#ifdef __AVX2__
+		__m256i lll162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][0])));
+		__m256i hll162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][1])));
+		__m256i llh162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][0])));
+		__m256i hlh162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][1])));
+		__m256i lhl162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[2][0])));
+		__m256i hhl162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[2][1])));
+		__m256i lhh162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[3][0])));
+		__m256i hhh162 = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(lut[3][1])));
+		for (int i = 0; i < size; i += 32, a += 32, c += 32) {
+			__m256i al16 = _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(a, 32)));
+			__m256i ah16 = _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(a+16, 32)));
+			__m256i al32 = _mm256_or_si256(_mm256_slli_epi16(ah16, 8), _mm256_and_si256(al16, _mm256_set1_epi16(255)));
+			__m256i ah32 = _mm256_or_si256(_mm256_and_si256(ah16, _mm256_set1_epi16(0xff00)), _mm256_srli_epi16(al16, 8));
+			__m256i alln = _mm256_and_si256(al32, _mm256_set1_epi8(15));
+			__m256i alhn = _mm256_and_si256(_mm256_srli_epi16(al32, 4), _mm256_set1_epi8(15));
+			__m256i ahln = _mm256_and_si256(ah32, _mm256_set1_epi8(15));
+			__m256i ahhn = _mm256_and_si256(_mm256_srli_epi16(ah32, 4), _mm256_set1_epi8(15));
+			__m256i cl32 = _mm256_xor_si256(_mm256_xor_si256(_mm256_shuffle_epi8(lll162, alln), _mm256_shuffle_epi8(llh162, alhn)), _mm256_xor_si256(_mm256_shuffle_epi8(lhl162, ahln), _mm256_shuffle_epi8(lhh162, ahhn)));
+			__m256i ch32 = _mm256_xor_si256(_mm256_xor_si256(_mm256_shuffle_epi8(hll162, alln), _mm256_shuffle_epi8(hlh162, alhn)), _mm256_xor_si256(_mm256_shuffle_epi8(hhl162, ahln), _mm256_shuffle_epi8(hhh162, ahhn)));
+			__m256i cl16 = _mm256_or_si256(_mm256_slli_epi16(ch32, 8), _mm256_and_si256(cl32, _mm256_set1_epi16(255)));
+			__m256i ch16 = _mm256_or_si256(_mm256_and_si256(ch32, _mm256_set1_epi16(0xff00)), _mm256_srli_epi16(cl32, 8));
+			if (!init) {
+				cl16 = _mm256_xor_si256(cl16, _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(c, 32))));
+				ch16 = _mm256_xor_si256(ch16, _mm256_load_si256(reinterpret_cast<const __m256i *>(__builtin_assume_aligned(c+16, 32))));
+			}
+			_mm256_store_si256(reinterpret_cast<__m256i *>(__builtin_assume_aligned(c, 32)), cl16);
+			_mm256_store_si256(reinterpret_cast<__m256i *>(__builtin_assume_aligned(c+16, 32)), ch16);
+		}
+#else
+		__m128i lll16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][0]));
+		__m128i hll16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[0][1]));
+		__m128i llh16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][0]));
+		__m128i hlh16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[1][1]));
+		__m128i lhl16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[2][0]));
+		__m128i hhl16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[2][1]));
+		__m128i lhh16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[3][0]));
+		__m128i hhh16 = _mm_load_si128(reinterpret_cast<const __m128i *>(lut[3][1]));
+		for (int i = 0; i < size; i += 16, a += 16, c += 16) {
+			__m128i al8 = _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(a, 16)));
+			__m128i ah8 = _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(a+8, 16)));
+			__m128i al16 = _mm_or_si128(_mm_slli_epi16(ah8, 8), _mm_and_si128(al8, _mm_set1_epi16(255)));
+			__m128i ah16 = _mm_or_si128(_mm_and_si128(ah8, _mm_set1_epi16(0xff00)), _mm_srli_epi16(al8, 8));
+			__m128i alln = _mm_and_si128(al16, _mm_set1_epi8(15));
+			__m128i alhn = _mm_and_si128(_mm_srli_epi16(al16, 4), _mm_set1_epi8(15));
+			__m128i ahln = _mm_and_si128(ah16, _mm_set1_epi8(15));
+			__m128i ahhn = _mm_and_si128(_mm_srli_epi16(ah16, 4), _mm_set1_epi8(15));
+			__m128i cl16 = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(lll16, alln), _mm_shuffle_epi8(llh16, alhn)), _mm_xor_si128(_mm_shuffle_epi8(lhl16, ahln), _mm_shuffle_epi8(lhh16, ahhn)));
+			__m128i ch16 = _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(hll16, alln), _mm_shuffle_epi8(hlh16, alhn)), _mm_xor_si128(_mm_shuffle_epi8(hhl16, ahln), _mm_shuffle_epi8(hhh16, ahhn)));
+			__m128i cl8 = _mm_or_si128(_mm_slli_epi16(ch16, 8), _mm_and_si128(cl16, _mm_set1_epi16(255)));
+			__m128i ch8 = _mm_or_si128(_mm_and_si128(ch16, _mm_set1_epi16(0xff00)), _mm_srli_epi16(cl16, 8));
+			if (!init) {
+				cl8 = _mm_xor_si128(cl8, _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(c, 16))));
+				ch8 = _mm_xor_si128(ch8, _mm_load_si128(reinterpret_cast<const __m128i *>(__builtin_assume_aligned(c+8, 16))));
+			}
+			_mm_store_si128(reinterpret_cast<__m128i *>(__builtin_assume_aligned(c, 16)), cl8);
+			_mm_store_si128(reinterpret_cast<__m128i *>(__builtin_assume_aligned(c+8, 16)), ch8);
+		}
+#endif
+#endif
+	}
+#endif
+public:
+	ConstantMultiply() {}
+	explicit ConstantMultiply(IndexType b)
+	{
+		*this = b;
+	}
+	ConstantMultiply<GF> &operator = (IndexType b)
+	{
+		for (int n = 0; n < 2*S; ++n) {
+			for (int i = 0; i < 16; ++i) {
+				int a = i << (4*n);
+				value_type c = a <= GF::N ? (b * ValueType(a)).v : 0;
+				for (int k = 0; k < S; ++k)
+					lut[n][k][i] = c >> (8*k);
+			}
+		}
+		return *this;
+	}
+	ValueType operator()(ValueType a) const
+	{
+		value_type c = 0;
+		for (int n = 0; n < 2*S; ++n)
+			for (int k = 0; k < S; ++k)
+				c ^= value_type(lut[n][k][(a.v>>(4*n))&15]) << (8*k);
+		return ValueType(c);
+	}
+	// $c = b \cdot a$ or $c = c + b \cdot a$, where c may alias a
+	__attribute__((flatten))
+	void operator()(ValueType *c, const ValueType *a, int len, bool init) const
+	{
+#if defined(__ARM_NEON) || defined(__AVX2__) || defined(__SSE4_1__)
+		if (reinterpret_cast<uintptr_t>(c) % SIMD == 0 && reinterpret_cast<uintptr_t>(a) % SIMD == 0 && len % SIMD == 0) {
+			simd(reinterpret_cast<value_type *>(c), reinterpret_cast<const value_type *>(a), len, init);
+		} else
+#endif
+		if (init) {
+			for (int i = 0; i < len; i++)
+				c[i] = (*this)(a[i]);
+		} else {
+			for (int i = 0; i < len; i++)
+				c[i] += (*this)(a[i]);
+		}
+	}
+};
+
+}
+
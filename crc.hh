@@ -6,12 +6,36 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 
 #pragma once
 
+#include <cstddef>
+#include <cstring>
+#include "parallel.hh"
+#ifdef __PCLMUL__
+#include <immintrin.h>
+#endif
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#endif
+#if defined(__ARM_NEON) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define CRC_PMULL 1
+#endif
+
 namespace CODE {
 
-template <typename TYPE>
+// slicing by 8 or 16 speeds up update() on long buffers, at the cost of 8 or 16 tables instead of one
+template <typename TYPE, int SLICES = 1>
 class CRC
 {
-	TYPE lut[256];
+	static_assert(SLICES == 1 || SLICES == 8 || SLICES == 16, "only slicing by 1, 8 or 16 supported");
+	// $lut_{j,i} = crc(i \cdot x^{8j})$
+	TYPE lut[SLICES][256];
+#if defined(__PCLMUL__) || defined(CRC_PMULL)
+	// $fold_{n,0} = x^{n+63} \bmod{poly}$, $fold_{n,1} = x^{n-1} \bmod{poly}$ bit reflected in 64 bits
+	uint64_t fold128[2], fold512[2];
+#endif
 	TYPE poly;
 	TYPE crc;
 	TYPE update(TYPE prev, bool data)
@@ -19,6 +43,173 @@ class CRC
 		TYPE tmp = prev ^ data;
 		return (prev >> 1) ^ ((tmp & 1) * poly);
 	}
+	TYPE slice(TYPE prev, const uint8_t *data, int table)
+	{
+		// the crc gets mixed into the first bytes, each byte then has its own table
+		uint64_t word = uint64_t(data[0]) | uint64_t(data[1]) << 8 |
+			uint64_t(data[2]) << 16 | uint64_t(data[3]) << 24 |
+			uint64_t(data[4]) << 32 | uint64_t(data[5]) << 40 |
+			uint64_t(data[6]) << 48 | uint64_t(data[7]) << 56;
+		word ^= prev;
+		return lut[table+7][word & 255] ^ lut[table+6][(word >> 8) & 255] ^
+			lut[table+5][(word >> 16) & 255] ^ lut[table+4][(word >> 24) & 255] ^
+			lut[table+3][(word >> 32) & 255] ^ lut[table+2][(word >> 40) & 255] ^
+			lut[table+1][(word >> 48) & 255] ^ lut[table][word >> 56];
+	}
+	uint64_t power(int n)
+	{
+		// the register holds $x^0$ in its top bit and each update multiplies by $x$
+		TYPE tmp = TYPE(1) << (8 * sizeof(TYPE) - 1);
+		for (int i = 0; i < n; ++i)
+			tmp = update(tmp, 0);
+		return uint64_t(tmp) << (64 - 8 * sizeof(TYPE));
+	}
+	TYPE multiply(TYPE a, TYPE b)
+	{
+		// $a \cdot b \bmod{poly}$ with $x^0$ in the top bit
+		TYPE prod = 0;
+		for (TYPE m = TYPE(1) << (8 * sizeof(TYPE) - 1); m; m >>= 1) {
+			if (a & m)
+				prod ^= b;
+			b = update(b, 0);
+		}
+		return prod;
+	}
+	TYPE zeros(size_t len)
+	{
+		// $x^{8 \cdot len} \bmod{poly}$ by square and multiply
+		TYPE prod = TYPE(1) << (8 * sizeof(TYPE) - 1), sqr = prod;
+		for (int i = 0; i < 8; ++i)
+			sqr = update(sqr, 0);
+		for (; len; len >>= 1) {
+			if (len & 1)
+				prod = multiply(prod, sqr);
+			sqr = multiply(sqr, sqr);
+		}
+		return prod;
+	}
+	TYPE bytes(TYPE prev, const uint8_t *data, size_t len)
+	{
+		for (; len; --len, ++data)
+			prev = (prev >> 8) ^ lut[0][(prev ^ *data) & 255];
+		return prev;
+	}
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+	static uint32_t crc32c(uint32_t prev, const uint8_t *data)
+	{
+		uint64_t word;
+		std::memcpy(&word, data, 8);
+#ifdef __SSE4_2__
+		return _mm_crc32_u64(prev, word);
+#else
+		return __crc32cd(prev, word);
+#endif
+	}
+	TYPE castagnoli(TYPE prev, const uint8_t *data, size_t len)
+	{
+		// three independent streams hide the latency of the crc instruction
+		const size_t BLK = 4096;
+		if (len >= 3 * BLK) {
+			TYPE shift1 = zeros(BLK), shift2 = zeros(2 * BLK);
+			for (; len >= 3 * BLK; len -= 3 * BLK, data += 3 * BLK) {
+				uint32_t crc0 = prev, crc1 = 0, crc2 = 0;
+				for (size_t i = 0; i < BLK; i += 8) {
+					crc0 = crc32c(crc0, data + i);
+					crc1 = crc32c(crc1, data + BLK + i);
+					crc2 = crc32c(crc2, data + 2 * BLK + i);
+				}
+				prev = multiply(crc0, shift2) ^ multiply(crc1, shift1) ^ crc2;
+			}
+		}
+		for (; len >= 8; len -= 8, data += 8)
+			prev = crc32c(prev, data);
+		return bytes(prev, data, len);
+	}
+#endif
+	TYPE compute(TYPE prev, const uint8_t *data, size_t len)
+	{
+#if defined(__PCLMUL__) || defined(CRC_PMULL)
+		// fold 64 bytes at a time with carry-less multiplications, the table takes care of the rest
+		if (len >= 128) {
+			size_t blocks = len & ~size_t(63);
+			prev = clmul(prev, data, blocks);
+			data += blocks;
+			len -= blocks;
+		}
+#endif
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
+		// folding is still faster for long buffers, but nothing beats the crc instruction on the rest
+		if (sizeof(TYPE) == 4 && poly == TYPE(0x82F63B78))
+			return castagnoli(prev, data, len);
+#endif
+		if (SLICES == 16) {
+			for (; len >= 16; len -= 16, data += 16)
+				prev = slice(prev, data, 8) ^ slice(0, data + 8, 0);
+		}
+		if (SLICES >= 8) {
+			for (; len >= 8; len -= 8, data += 8)
+				prev = slice(prev, data, 0);
+		}
+		return bytes(prev, data, len);
+	}
+#ifdef __PCLMUL__
+	static __m128i fold(__m128i a, __m128i k)
+	{
+		return _mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00), _mm_clmulepi64_si128(a, k, 0x11));
+	}
+	TYPE clmul(TYPE prev, const uint8_t *data, size_t len)
+	{
+		// $a \cdot x^{n} = a_0 \cdot x^{n+64} + a_1 \cdot x^{n}$ and the carry-less product of reflected operands gains a factor $x$
+		__m128i k128 = _mm_set_epi64x(fold128[1], fold128[0]);
+		__m128i k512 = _mm_set_epi64x(fold512[1], fold512[0]);
+		const __m128i *blk = reinterpret_cast<const __m128i *>(data);
+		__m128i a0 = _mm_xor_si128(_mm_loadu_si128(blk), _mm_cvtsi64_si128(prev));
+		__m128i a1 = _mm_loadu_si128(blk + 1);
+		__m128i a2 = _mm_loadu_si128(blk + 2);
+		__m128i a3 = _mm_loadu_si128(blk + 3);
+		for (size_t i = 4; i < len / 16; i += 4) {
+			a0 = _mm_xor_si128(fold(a0, k512), _mm_loadu_si128(blk + i));
+			a1 = _mm_xor_si128(fold(a1, k512), _mm_loadu_si128(blk + i + 1));
+			a2 = _mm_xor_si128(fold(a2, k512), _mm_loadu_si128(blk + i + 2));
+			a3 = _mm_xor_si128(fold(a3, k512), _mm_loadu_si128(blk + i + 3));
+		}
+		a0 = _mm_xor_si128(fold(a0, k128), a1);
+		a0 = _mm_xor_si128(fold(a0, k128), a2);
+		a0 = _mm_xor_si128(fold(a0, k128), a3);
+		uint8_t buf[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(buf), a0);
+		return bytes(0, buf, 16);
+	}
+#endif
+#ifdef CRC_PMULL
+	static uint64x2_t fold(uint64x2_t a, uint64x2_t k)
+	{
+		uint64x2_t lo = vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(a, 0), vgetq_lane_u64(k, 0)));
+		uint64x2_t hi = vreinterpretq_u64_p128(vmull_p64(vgetq_lane_u64(a, 1), vgetq_lane_u64(k, 1)));
+		return veorq_u64(lo, hi);
+	}
+	TYPE clmul(TYPE prev, const uint8_t *data, size_t len)
+	{
+		uint64x2_t k128 = vld1q_u64(fold128);
+		uint64x2_t k512 = vld1q_u64(fold512);
+		uint64x2_t a0 = veorq_u64(vreinterpretq_u64_u8(vld1q_u8(data)), vsetq_lane_u64(uint64_t(prev), vdupq_n_u64(0), 0));
+		uint64x2_t a1 = vreinterpretq_u64_u8(vld1q_u8(data + 16));
+		uint64x2_t a2 = vreinterpretq_u64_u8(vld1q_u8(data + 32));
+		uint64x2_t a3 = vreinterpretq_u64_u8(vld1q_u8(data + 48));
+		for (size_t i = 64; i < len; i += 64) {
+			a0 = veorq_u64(fold(a0, k512), vreinterpretq_u64_u8(vld1q_u8(data + i)));
+			a1 = veorq_u64(fold(a1, k512), vreinterpretq_u64_u8(vld1q_u8(data + i + 16)));
+			a2 = veorq_u64(fold(a2, k512), vreinterpretq_u64_u8(vld1q_u8(data + i + 32)));
+			a3 = veorq_u64(fold(a3, k512), vreinterpretq_u64_u8(vld1q_u8(data + i + 48)));
+		}
+		a0 = veorq_u64(fold(a0, k128), a1);
+		a0 = veorq_u64(fold(a0, k128), a2);
+		a0 = veorq_u64(fold(a0, k128), a3);
+		uint8_t buf[16];
+		vst1q_u8(buf, vreinterpretq_u8_u64(a0));
+		return bytes(0, buf, 16);
+	}
+#endif
 public:
 	CRC(TYPE poly, TYPE crc = 0) : poly(poly), crc(crc)
 	{
@@ -26,8 +217,17 @@ public:
 			TYPE tmp = j;
 			for (int i = 8; i; --i)
 				tmp = update(tmp, 0);
-			lut[j] = tmp;
+			lut[0][j] = tmp;
 		}
+		for (int i = 1; i < SLICES; ++i)
+			for (int j = 0; j < 256; ++j)
+				lut[i][j] = (lut[i-1][j] >> 8) ^ lut[0][lut[i-1][j] & 255];
+#if defined(__PCLMUL__) || defined(CRC_PMULL)
+		fold128[0] = power(128 + 63);
+		fold128[1] = power(128 - 1);
+		fold512[0] = power(512 + 63);
+		fold512[1] = power(512 - 1);
+#endif
 	}
 	void reset(TYPE v = 0)
 	{
@@ -44,42 +244,152 @@ public:
 	TYPE operator()(uint8_t data)
 	{
 		TYPE tmp = crc ^ data;
-		return crc = (crc >> 8) ^ lut[tmp & 255];
+		return crc = (crc >> 8) ^ lut[0][tmp & 255];
 	}
-
 	TYPE operator()(uint16_t data)
 	{
-		(*this)(uint8_t(data & 255));
-		(*this)(uint8_t((data >> 8) & 255));
-		return crc;
+		uint8_t buf[2] = { uint8_t(data), uint8_t(data >> 8) };
+		return update(buf, 2);
 	}
 	TYPE operator()(uint32_t data)
 	{
-		(*this)(uint8_t(data & 255));
-		(*this)(uint8_t((data >> 8) & 255));
-		(*this)(uint8_t((data >> 16) & 255));
-		(*this)(uint8_t((data >> 24) & 255));
-		return crc;
+		uint8_t buf[4];
+		for (int i = 0; i < 4; ++i)
+			buf[i] = data >> (8 * i);
+		return update(buf, 4);
 	}
 	TYPE operator()(uint64_t data)
 	{
-		(*this)(uint8_t(data & 255));
-		(*this)(uint8_t((data >> 8) & 255));
-		(*this)(uint8_t((data >> 16) & 255));
-		(*this)(uint8_t((data >> 24) & 255));
-		(*this)(uint8_t((data >> 32) & 255));
-		(*this)(uint8_t((data >> 40) & 255));
-		(*this)(uint8_t((data >> 48) & 255));
-		(*this)(uint8_t((data >> 56) & 255));
-		return crc;
+		uint8_t buf[8];
+		for (int i = 0; i < 8; ++i)
+			buf[i] = data >> (8 * i);
+		return update(buf, 8);
+	}
+	TYPE update(const uint8_t *data, size_t len)
+	{
+		return crc = compute(crc, data, len);
+	}
+	TYPE update(const uint8_t *data, size_t len, int threads)
+	{
+		// every thread gets a segment, which starts from zero and is then appended with combine()
+		const size_t MIN = 1 << 16;
+		if (threads > int(len / MIN))
+			threads = len / MIN;
+		if (threads < 2)
+			return update(data, len);
+		size_t seg = len / threads;
+		std::vector<TYPE> part(threads);
+		parallel_for(threads, threads, [&](int t) {
+			size_t end = t == threads - 1 ? len : (t + 1) * seg;
+			part[t] = compute(t ? 0 : crc, data + t * seg, end - t * seg);
+		});
+		for (int t = 1; t < threads; ++t)
+			part[0] = combine(part[0], part[t], (t == threads - 1 ? len : (t + 1) * seg) - t * seg);
+		return crc = part[0];
+	}
+	// crc of a followed by b, where crc_b was computed starting from zero
+	TYPE combine(TYPE crc_a, TYPE crc_b, size_t len_b)
+	{
+		return multiply(crc_a, zeros(len_b)) ^ crc_b;
 	}
 };
 
 template<>
 uint8_t CRC<uint8_t>::operator()(uint8_t data)
 {
-	return crc = lut[crc ^ data];
+	return crc = lut[0][crc ^ data];
 }
 
+// polynomial known at compile time: the slicing tables get computed by the compiler and shared by all instances
+template <typename TYPE, TYPE POLY>
+class StaticCRC
+{
+	struct Tables
+	{
+		// $lut_{j,i} = crc(i \cdot x^{8j})$
+		TYPE lut[8][256];
+		constexpr Tables() : lut()
+		{
+			for (int j = 0; j < 256; ++j) {
+				TYPE tmp = j;
+				for (int i = 8; i; --i)
+					tmp = (tmp >> 1) ^ ((tmp & 1) * POLY);
+				lut[0][j] = tmp;
+			}
+			for (int i = 1; i < 8; ++i)
+				for (int j = 0; j < 256; ++j)
+					lut[i][j] = (lut[i-1][j] >> 8) ^ lut[0][lut[i-1][j] & 255];
+		}
+	};
+	static constexpr Tables tables = Tables();
+	TYPE crc;
+	static TYPE slice(TYPE prev, const uint8_t *data)
+	{
+		uint64_t word = uint64_t(data[0]) | uint64_t(data[1]) << 8 |
+			uint64_t(data[2]) << 16 | uint64_t(data[3]) << 24 |
+			uint64_t(data[4]) << 32 | uint64_t(data[5]) << 40 |
+			uint64_t(data[6]) << 48 | uint64_t(data[7]) << 56;
+		word ^= prev;
+		const TYPE (*lut)[256] = tables.lut;
+		return lut[7][word & 255] ^ lut[6][(word >> 8) & 255] ^
+			lut[5][(word >> 16) & 255] ^ lut[4][(word >> 24) & 255] ^
+			lut[3][(word >> 32) & 255] ^ lut[2][(word >> 40) & 255] ^
+			lut[1][(word >> 48) & 255] ^ lut[0][word >> 56];
+	}
+	static TYPE byte(TYPE prev, uint8_t data)
+	{
+		return (prev >> 8) ^ tables.lut[0][(prev ^ data) & 255];
+	}
+public:
+	constexpr StaticCRC(TYPE crc = 0) : crc(crc)
+	{
+	}
+	void reset(TYPE v = 0)
+	{
+		crc = v;
+	}
+	TYPE operator()()
+	{
+		return crc;
+	}
+	TYPE operator()(bool data)
+	{
+		TYPE tmp = crc ^ data;
+		return crc = (crc >> 1) ^ ((tmp & 1) * POLY);
+	}
+	TYPE operator()(uint8_t data)
+	{
+		return crc = byte(crc, data);
+	}
+	TYPE operator()(uint16_t data)
+	{
+		uint8_t buf[2] = { uint8_t(data), uint8_t(data >> 8) };
+		return update(buf, 2);
+	}
+	TYPE operator()(uint32_t data)
+	{
+		uint8_t buf[4];
+		for (int i = 0; i < 4; ++i)
+			buf[i] = data >> (8 * i);
+		return update(buf, 4);
+	}
+	TYPE operator()(uint64_t data)
+	{
+		uint8_t buf[8];
+		for (int i = 0; i < 8; ++i)
+			buf[i] = data >> (8 * i);
+		return update(buf, 8);
+	}
+	TYPE update(const uint8_t *data, size_t len)
+	{
+		size_t i = 0;
+		for (; i + 8 <= len; i += 8)
+			crc = slice(crc, data + i);
+		for (; i < len; ++i)
+			crc = byte(crc, data[i]);
+		return crc;
+	}
+};
+
 }
 
@@ -0,0 +1,174 @@
+/*
+LDPC SISO layered decoder keeping only a compressed state per check node
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <vector>
+#include "ldpc_kernel.hh"
+
+namespace CODE {
+
+template <typename TABLE, int BETA>
+class LDPCCompactDecoder
+{
+	static const int M = TABLE::M;
+	static const int N = TABLE::N;
+	static const int K = TABLE::K;
+	static const int R = N-K;
+	static const int q = R/M;
+	static const int CNC = TABLE::LINKS_MAX_CN - 2;
+	typedef LDPCKernel<BETA, N / LDPCRuntimeTable::D, R / LDPCRuntimeTable::D, CNC> KERNEL;
+	static const int D = KERNEL::D;
+	static_assert(M % D == 0, "M must be multiple of word size");
+	static const int W = M/D;
+	static const int PTY = R/D;
+	static_assert(CNC + 2 <= 64, "argmin index needs to fit into six bits");
+	// two vectors with the minima and the argmin, then a sign and a zero bit for every link
+	static const int CNS = PTY * (2 + (2 * (CNC + 2) + 7) / 8);
+
+	typedef typename KERNEL::TYPE TYPE;
+	typedef typename KERNEL::Loc Loc;
+	typedef typename KERNEL::wd_t wd_t;
+
+	KERNEL kernel;
+	TYPE cns[CNS];
+	// write disabled links keep their old message, this only happens to links rotated into the same word
+	std::vector<TYPE> side;
+	// the masks used by the last update, telling which links are in side
+	wd_t prv[PTY];
+
+	static TYPE band(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vand(vmask(a), vmask(b)));
+	}
+	void update()
+	{
+		auto links = kernel.links();
+		const uint8_t *cnc = kernel.cnc;
+		wd_t *wd = kernel.wd;
+		TYPE *cs = cns, *sd = side.data();
+		const Loc *lo = kernel.loc;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			int deg = cnt + 2;
+			int bytes = (2 * deg + 7) / 8;
+			for (int j = 0; j < W; ++j) {
+				TYPE mags[CNC+2], inps[CNC+2], olds[CNC+2];
+				TYPE min0 = vdup<TYPE>(127);
+				TYPE min1 = vdup<TYPE>(127);
+				TYPE signs = vdup<TYPE>(127);
+				TYPE arg0 = vzero<TYPE>(), arg1 = vzero<TYPE>();
+
+				// the magnitudes are at most 31, leaving the upper three bits of both for the argmin
+				TYPE low = band(cs[0], vdup<TYPE>(31));
+				TYPE high = band(cs[1], vdup<TYPE>(31));
+				TYPE idx0 = band(cs[0], vdup<TYPE>(int8_t(224)));
+				TYPE idx1 = band(cs[1], vdup<TYPE>(int8_t(224)));
+				TYPE *sp = sd;
+
+				for (int k = 0; k < deg; ++k) {
+					TYPE old;
+					if (k < cnt && (prv[W*i+j] >> k) & 1) {
+						old = *sp++;
+					} else {
+						auto arg = vand(vceq(idx0, vdup<TYPE>(int8_t((k & 7) << 5))), vceq(idx1, vdup<TYPE>(int8_t((k >> 3) << 5))));
+						TYPE mag = vreinterpret<TYPE>(vbsl(arg, vmask(high), vmask(low)));
+						int shift = 2 * (k % 4);
+						TYPE sgn = band(cs[2 + k / 4], vdup<TYPE>(int8_t(1 << shift)));
+						TYPE zero = band(cs[2 + k / 4], vdup<TYPE>(int8_t(2 << shift)));
+						old = vreinterpret<TYPE>(vbsl(vceqz(sgn), vmask(mag), vmask(vqsub(vzero<TYPE>(), mag))));
+						old = vreinterpret<TYPE>(vand(vmask(old), vceqz(zero)));
+					}
+					olds[k] = old;
+
+					TYPE inp = vqsub(links.get(lo, i, j, k, cnt), old);
+
+					TYPE mag = vqabs(inp);
+
+					if (BETA) {
+						auto beta = vunsigned(vdup<TYPE>(BETA));
+						mag = vsigned(vqsub(vunsigned(mag), beta));
+					}
+
+					// first link with the smallest magnitude, ties don't matter as min1 equals min0 then
+					auto less = vcgt(min0, mag);
+					arg0 = vreinterpret<TYPE>(vbsl(less, vmask(vdup<TYPE>(int8_t((k & 7) << 5))), vmask(arg0)));
+					arg1 = vreinterpret<TYPE>(vbsl(less, vmask(vdup<TYPE>(int8_t((k >> 3) << 5))), vmask(arg1)));
+
+					min1 = vmin(min1, vmax(min0, mag));
+					min0 = vmin(min0, mag);
+
+					signs = KERNEL::eor(signs, inp);
+
+					inps[k] = inp;
+					mags[k] = mag;
+				}
+				TYPE flags[(2 * (CNC + 2) + 7) / 8];
+				for (int b = 0; b < bytes; ++b)
+					flags[b] = vzero<TYPE>();
+				TYPE *sq = sd;
+				for (int k = 0; k < deg; ++k) {
+					TYPE mag = mags[k];
+					TYPE inp = inps[k];
+
+					TYPE out = vsign(KERNEL::other(mag, min0, min1), KERNEL::mine(signs, inp));
+
+					out = vclamp(out, -31, 31);
+
+					out = KERNEL::selfcorr(olds[k], out);
+
+					TYPE tmp = vqadd(inp, out);
+
+					int shift = 2 * (k % 4);
+					flags[k / 4] = KERNEL::orr(flags[k / 4], band(vreinterpret<TYPE>(vcltz(out)), vdup<TYPE>(int8_t(1 << shift))));
+					flags[k / 4] = KERNEL::orr(flags[k / 4], band(vreinterpret<TYPE>(vceqz(out)), vdup<TYPE>(int8_t(2 << shift))));
+
+					if (k < cnt && (wd[W*i+j] >> k) & 1)
+						*sq++ = olds[k];
+					else
+						links.set(lo, i, j, k, cnt, tmp);
+				}
+				cs[0] = KERNEL::orr(vmin(min0, vdup<TYPE>(31)), arg0);
+				cs[1] = KERNEL::orr(vmin(min1, vdup<TYPE>(31)), arg1);
+				for (int b = 0; b < bytes; ++b)
+					cs[2 + b] = flags[b];
+				prv[W*i+j] = wd[W*i+j];
+				KERNEL::advance(wd[W*i+j], lo, cnt);
+				lo += cnt;
+				cs += 2 + bytes;
+				sd = sq;
+			}
+		}
+	}
+public:
+	LDPCCompactDecoder()
+	{
+		kernel.reset(ldpc_layout<TABLE>());
+		// rotating the masks keeps the number of disabled links
+		int slots = 0;
+		for (int i = 0; i < PTY; ++i)
+			for (int c = 0; c < CNC; ++c)
+				slots += (kernel.wd[i] >> c) & 1;
+		side.resize(slots);
+	}
+	int operator()(int8_t *message, int8_t *parity, int trials = 25)
+	{
+		for (int i = 0; i < CNS; ++i)
+			cns[i] = vzero<TYPE>();
+		for (auto &sd: side)
+			sd = vzero<TYPE>();
+		for (int i = 0; i < PTY; ++i)
+			prv[i] = kernel.wd[i];
+		kernel.load(message, parity);
+		while (kernel.bad() && --trials >= 0)
+			update();
+		kernel.store(message, parity);
+		return trials;
+	}
+};
+
+}
+
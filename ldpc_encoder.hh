@@ -18,41 +18,55 @@ class LDPCEncoder
 	static const int q = R/M;
 	static const int CNC = TABLE::LINKS_MAX_CN - 2;
 
-	uint16_t pos[R * CNC];
-	uint8_t cnc[q];
-public:
-	LDPCEncoder()
+	// built by the first instance and shared read-only by all of them
+	struct Layout
 	{
-		for (int i = 0; i < q; ++i)
-			cnc[i] = 0;
-		int bit_pos = 0;
-		const int *row_ptr = TABLE::POS;
-		for (int g = 0; TABLE::LEN[g]; ++g) {
-			int bit_deg = TABLE::DEG[g];
-			for (int r = 0; r < TABLE::LEN[g]; ++r) {
-				for (int d = 0; d < bit_deg; ++d) {
-					int n = row_ptr[d] % q;
-					int m = row_ptr[d] / q;
-					pos[CNC*n+cnc[n]++] = bit_pos + (M - m) % M;
+		uint16_t pos[R * CNC];
+		uint8_t cnc[q];
+		Layout()
+		{
+			for (int i = 0; i < q; ++i)
+				cnc[i] = 0;
+			int bit_pos = 0;
+			const int *row_ptr = TABLE::POS;
+			for (int g = 0; TABLE::LEN[g]; ++g) {
+				int bit_deg = TABLE::DEG[g];
+				for (int r = 0; r < TABLE::LEN[g]; ++r) {
+					for (int d = 0; d < bit_deg; ++d) {
+						int n = row_ptr[d] % q;
+						int m = row_ptr[d] / q;
+						pos[CNC*n+cnc[n]++] = bit_pos + (M - m) % M;
+					}
+					row_ptr += bit_deg;
+					bit_pos += M;
 				}
-				row_ptr += bit_deg;
-				bit_pos += M;
-			}
-		}
-		for (int i = 0; i < q; ++i) {
-			int cnt = cnc[i];
-			int offset[CNC], shift[CNC];
-			for (int c = 0; c < cnt; ++c) {
-				shift[c] = pos[CNC*i+c] % M;
-				offset[c] = pos[CNC*i+c] - shift[c];
 			}
-			for (int j = 1; j < M; ++j) {
+			for (int i = 0; i < q; ++i) {
+				int cnt = cnc[i];
+				int offset[CNC], shift[CNC];
 				for (int c = 0; c < cnt; ++c) {
-					shift[c] = (shift[c] + 1) % M;
-					pos[CNC*(q*j+i)+c] = offset[c] + shift[c];
+					shift[c] = pos[CNC*i+c] % M;
+					offset[c] = pos[CNC*i+c] - shift[c];
+				}
+				for (int j = 1; j < M; ++j) {
+					for (int c = 0; c < cnt; ++c) {
+						shift[c] = (shift[c] + 1) % M;
+						pos[CNC*(q*j+i)+c] = offset[c] + shift[c];
+					}
 				}
 			}
 		}
+	};
+	static const Layout &layout()
+	{
+		static const Layout instance;
+		return instance;
+	}
+	const uint16_t *pos;
+	const uint8_t *cnc;
+public:
+	LDPCEncoder() : pos(layout().pos), cnc(layout().cnc)
+	{
 	}
 	void operator()(const int8_t *data, int8_t *parity)
 	{
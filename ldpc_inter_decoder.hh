@@ -0,0 +1,234 @@
+/*
+LDPC SISO layered decoder working on multiple frames at once
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "simd.hh"
+
+namespace CODE {
+
+// built by the first decoder that needs it and shared read-only by all decoders of that TABLE, whatever their BETA
+template <typename TABLE>
+struct LDPCInterLayout
+{
+	static const int M = TABLE::M;
+	static const int N = TABLE::N;
+	static const int K = TABLE::K;
+	static const int q = (N-K)/M;
+	static const int CNC = TABLE::LINKS_MAX_CN - 2;
+	static const int BNL = TABLE::LINKS_TOTAL;
+	uint16_t pos[BNL];
+	uint8_t cnc[q];
+	LDPCInterLayout()
+	{
+		uint16_t first[q * CNC];
+		for (int i = 0; i < q; ++i)
+			cnc[i] = 0;
+		int bit_pos = 0;
+		const int *row_ptr = TABLE::POS;
+		for (int g = 0; TABLE::LEN[g]; ++g) {
+			int bit_deg = TABLE::DEG[g];
+			for (int r = 0; r < TABLE::LEN[g]; ++r) {
+				for (int d = 0; d < bit_deg; ++d) {
+					int n = row_ptr[d] % q;
+					int m = row_ptr[d] / q;
+					first[CNC*n+cnc[n]++] = bit_pos + (M - m) % M;
+				}
+				row_ptr += bit_deg;
+				bit_pos += M;
+			}
+		}
+		// check node $q \cdot j + i$ links to message bits, its parity bit and the parity bit before
+		uint16_t *ps = pos;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			for (int j = 0; j < M; ++j) {
+				for (int c = 0; c < cnt; ++c) {
+					int shift = first[CNC*i+c] % M;
+					int offset = first[CNC*i+c] - shift;
+					*ps++ = offset + (shift + j) % M;
+				}
+				*ps++ = K + q*j+i;
+				if (i || j)
+					*ps++ = K + q*j+i - 1;
+			}
+		}
+		//assert(ps == pos + BNL);
+	}
+	static const LDPCInterLayout &get()
+	{
+		static const LDPCInterLayout instance;
+		return instance;
+	}
+};
+
+template <typename TABLE, int BETA>
+class LDPCInterDecoder
+{
+public:
+#ifdef __AVX2__
+	static const int SIMD_SIZE = 32;
+#else
+	static const int SIMD_SIZE = 16;
+#endif
+	static const int M = TABLE::M;
+	static const int N = TABLE::N;
+	static const int K = TABLE::K;
+	// each SIMD lane decodes its own frame
+	static const int FRAMES = SIMD_SIZE;
+private:
+	static const int R = N-K;
+	static const int q = R/M;
+	static const int CNC = TABLE::LINKS_MAX_CN - 2;
+	static const int BNL = TABLE::LINKS_TOTAL;
+
+	typedef SIMD<int8_t, SIMD_SIZE> TYPE;
+
+	TYPE bnl[BNL];
+	TYPE var[N];
+	const uint16_t *pos;
+	const uint8_t *cnc;
+
+	static TYPE eor(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(veor(vmask(a), vmask(b)));
+	}
+	static TYPE orr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vorr(vmask(a), vmask(b)));
+	}
+	static TYPE other(TYPE a, TYPE b, TYPE c)
+	{
+		return vreinterpret<TYPE>(vbsl(vceq(a, b), vmask(c), vmask(b)));
+	}
+	static TYPE mine(TYPE a, TYPE b)
+	{
+		return orr(eor(a, b), vdup<TYPE>(127));
+	}
+	static TYPE selfcorr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vand(vmask(b), vorr(vceqz(a), veor(vcgtz(a), vcltz(b)))));
+	}
+
+	// lanes with at least one unsatisfied check node
+	SIMD<uint8_t, SIMD_SIZE> bad()
+	{
+		auto res = vmask(vzero<TYPE>());
+		const uint16_t *ps = pos;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			for (int j = 0; j < M; ++j) {
+				// the very first check node has no previous parity bit to link to
+				int deg = cnt + 1 + (i || j);
+				TYPE cnv = vdup<TYPE>(1);
+				for (int k = 0; k < deg; ++k)
+					cnv = vsign(cnv, var[ps[k]]);
+				res = vorr(res, vclez(cnv));
+				ps += deg;
+			}
+		}
+		return res;
+	}
+	void update()
+	{
+		TYPE *bl = bnl;
+		const uint16_t *ps = pos;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			for (int j = 0; j < M; ++j) {
+				int deg = cnt + 1 + (i || j);
+				TYPE mags[CNC+2], inps[CNC+2];
+				TYPE min0 = vdup<TYPE>(127);
+				TYPE min1 = vdup<TYPE>(127);
+				TYPE signs = vdup<TYPE>(127);
+
+				for (int k = 0; k < deg; ++k) {
+					TYPE inp = vqsub(var[ps[k]], bl[k]);
+
+					TYPE mag = vqabs(inp);
+
+					if (BETA) {
+						auto beta = vunsigned(vdup<TYPE>(BETA));
+						mag = vsigned(vqsub(vunsigned(mag), beta));
+					}
+
+					min1 = vmin(min1, vmax(min0, mag));
+					min0 = vmin(min0, mag);
+
+					signs = eor(signs, inp);
+
+					inps[k] = inp;
+					mags[k] = mag;
+				}
+				for (int k = 0; k < deg; ++k) {
+					TYPE mag = mags[k];
+					TYPE inp = inps[k];
+
+					TYPE out = vsign(other(mag, min0, min1), mine(signs, inp));
+
+					out = vclamp(out, -31, 31);
+
+					out = selfcorr(bl[k], out);
+
+					bl[k] = out;
+					var[ps[k]] = vqadd(inp, out);
+				}
+				ps += deg;
+				bl += deg;
+			}
+		}
+	}
+public:
+	LDPCInterDecoder() : pos(LDPCInterLayout<TABLE>::get().pos), cnc(LDPCInterLayout<TABLE>::get().cnc)
+	{
+	}
+	// frame $n$ of $count$ is stored at $code + n \cdot N$, message first then parity
+	int operator()(int8_t *code, int count = FRAMES, int *results = 0, int trials = 25)
+	{
+		assert(0 < count && count <= FRAMES);
+		for (int i = 0; i < BNL; ++i)
+			bnl[i] = vzero<TYPE>();
+		// unused lanes get the all zero code word and converge right away
+		for (int i = 0; i < N; ++i) {
+			var[i] = vdup<TYPE>(127);
+			for (int n = 0; n < count; ++n)
+				var[i].v[n] = code[N*n+i];
+		}
+		bool done[FRAMES];
+		for (int n = 0; n < count; ++n)
+			done[n] = false;
+		int pending = count;
+		while (true) {
+			auto res = bad();
+			// copy out frames as they converge, so later iterations can't disturb them
+			for (int n = 0; n < count; ++n) {
+				if (!done[n] && !res.v[n]) {
+					for (int i = 0; i < N; ++i)
+						code[N*n+i] = var[i].v[n];
+					if (results)
+						results[n] = trials;
+					done[n] = true;
+					--pending;
+				}
+			}
+			if (!pending || --trials < 0)
+				break;
+			update();
+		}
+		for (int n = 0; n < count; ++n) {
+			if (!done[n]) {
+				for (int i = 0; i < N; ++i)
+					code[N*n+i] = var[i].v[n];
+				if (results)
+					results[n] = -1;
+			}
+		}
+		return trials;
+	}
+};
+
+}
+
@@ -0,0 +1,303 @@
+/*
+Kernel of the LDPC SISO layered decoders
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "simd.hh"
+#include "rotate.hh"
+#include "ldpc_runtime_table.hh"
+#include "ldpc_stats.hh"
+
+namespace CODE {
+
+// the values of codes laid out by an LDPCRuntimeTable, up to $VAR$ vectors of them and $PTY$ vectors of parity
+template <int BETA, int VAR, int PTY, int CNC = LDPCRuntimeTable::CNC_MAX>
+class LDPCKernel
+{
+public:
+#ifdef __AVX2__
+	static const int SIMD_SIZE = 32;
+#else
+	static const int SIMD_SIZE = 16;
+#endif
+	static const int D = LDPCRuntimeTable::D;
+	static_assert(D <= SIMD_SIZE, "SIMD size must be bigger or equal word size");
+	static_assert(sizeof(SIMD<int8_t, SIMD_SIZE>) == SIMD_SIZE, "native layout needs tightly packed vectors");
+	static_assert(CNC <= LDPCRuntimeTable::CNC_MAX, "write disable mask needs at least as many bits as max check node links");
+
+	typedef SIMD<int8_t, SIMD_SIZE> TYPE;
+	typedef LDPCRuntimeTable::Loc Loc;
+	typedef LDPCRuntimeTable::wd_t wd_t;
+
+	// kept in locals while decoding, so writing the values doesn't make the compiler load these again
+	struct Links
+	{
+		Rotate<TYPE, D> *rotate;
+		TYPE *msg, *pty;
+		int q, W;
+		// link $k$ of check node $W \cdot i + j$: $cnt$ message bits, its parity bit and the parity bit before
+		TYPE get(const Loc *lo, int i, int j, int k, int cnt)
+		{
+			if (k < cnt)
+				return (*rotate)(msg[lo[k].off], -lo[k].shi);
+			if (k == cnt)
+				return pty[W*i+j];
+			if (i)
+				return pty[W*(i-1)+j];
+			if (j)
+				return pty[W*(q-1)+j-1];
+			TYPE tmp = (*rotate)(pty[W*q-1], 1);
+			tmp.v[0] = 127;
+			return tmp;
+		}
+		void set(const Loc *lo, int i, int j, int k, int cnt, TYPE tmp)
+		{
+			if (k < cnt) {
+				msg[lo[k].off] = (*rotate)(tmp, lo[k].shi);
+			} else if (k == cnt) {
+				pty[W*i+j] = tmp;
+			} else if (i) {
+				pty[W*(i-1)+j] = tmp;
+			} else if (j) {
+				pty[W*(q-1)+j-1] = tmp;
+			} else {
+				tmp.v[0] = pty[W*q-1].v[D-1];
+				pty[W*q-1] = (*rotate)(tmp, -1);
+			}
+		}
+	};
+
+	Rotate<TYPE, D> rotate;
+	// message values first, then the parity values
+	TYPE var[VAR];
+	// the write disable masks get rotated while decoding, so every decoder needs its own copy
+	wd_t wd[PTY];
+	const Loc *loc;
+	const uint8_t *cnc;
+	int M, K, q, W;
+
+	static TYPE eor(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(veor(vmask(a), vmask(b)));
+	}
+	static TYPE orr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vorr(vmask(a), vmask(b)));
+	}
+	static TYPE other(TYPE a, TYPE b, TYPE c)
+	{
+		return vreinterpret<TYPE>(vbsl(vceq(a, b), vmask(c), vmask(b)));
+	}
+	static TYPE mine(TYPE a, TYPE b)
+	{
+		return orr(eor(a, b), vdup<TYPE>(127));
+	}
+	static TYPE selfcorr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vand(vmask(b), vorr(vceqz(a), veor(vcgtz(a), vcltz(b)))));
+	}
+	template <typename MASK>
+	static int lanes(MASK m)
+	{
+		int count = 0;
+		for (int n = 0; n < D; ++n)
+			count += !!m.v[n];
+		return count;
+	}
+	// links rotated into the same word take turns
+	static void advance(wd_t &mask, const Loc *lo, int cnt)
+	{
+		if (!mask)
+			return;
+		for (int first = 0, c = 1; c < cnt; ++c) {
+			if (lo[first].off != lo[c].off || c == cnt-1) {
+				int last = c - 1;
+				if (c == cnt-1)
+					++last;
+				if (last != first) {
+					int count = last - first + 1;
+					wd_t bits = ((1 << count) - 1) << first;
+					wd_t tmp = mask & bits;
+					wd_t ror = (tmp >> 1) | (tmp << (count-1));
+					mask = (mask & ~bits) | (ror & bits);
+				}
+				first = c;
+			}
+		}
+	}
+
+	void reset(const LDPCRuntimeTable &table)
+	{
+		assert(table.N / D <= VAR && table.q * table.W <= PTY && table.CNC <= CNC);
+		M = table.M;
+		K = table.K;
+		q = table.q;
+		W = table.W;
+		loc = table.loc.data();
+		cnc = table.cnc.data();
+		for (int i = 0; i < q * W; ++i)
+			wd[i] = table.wd[i];
+	}
+	Links links()
+	{
+		return Links { &rotate, var, var + K / D, q, W };
+	}
+	// each of the loop orders measured fastest on its own
+	void load(const int8_t *message, const int8_t *parity)
+	{
+		const int M = this->M, K = this->K, q = this->q, W = this->W;
+		TYPE *msg = var, *pty = var + K / D;
+		for (int i = 0; i < K/M; ++i)
+			for (int j = 0; j < W; ++j)
+				for (int n = 0; n < D; ++n)
+					msg[W*i+j].v[n] = message[M*i+W*n+j];
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < W; ++j)
+				for (int n = 0; n < D; ++n)
+					pty[W*i+j].v[n] = parity[q*(W*n+j)+i];
+	}
+	void store(int8_t *message, int8_t *parity)
+	{
+		const int M = this->M, K = this->K, q = this->q, W = this->W;
+		const TYPE *msg = var, *pty = var + K / D;
+		for (int i = 0; i < K/M; ++i)
+			for (int j = 0; j < W; ++j)
+				for (int n = 0; n < D; ++n)
+					message[M*i+W*n+j] = msg[W*i+j].v[n];
+		for (int n = 0; n < D; ++n)
+			for (int j = 0; j < W; ++j)
+				for (int i = 0; i < q; ++i)
+					parity[q*(W*n+j)+i] = pty[W*i+j].v[n];
+	}
+	// with COUNT we look at all check nodes, otherwise we stop at the first unsatisfied one
+	template <bool COUNT>
+	int unsatisfied()
+	{
+		Links links = this->links();
+		const int q = links.q, W = links.W;
+		const uint8_t *cnc = this->cnc;
+		const Loc *lo = loc;
+		int count = 0;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			int deg = cnt + 2;
+			auto res = vmask(vzero<TYPE>());
+			for (int j = 0; j < W; ++j) {
+				TYPE cnv = vdup<TYPE>(1);
+				for (int k = 0; k < deg; ++k)
+					cnv = vsign(cnv, links.get(lo, i, j, k, cnt));
+				if (COUNT)
+					count += lanes(vclez(cnv));
+				else
+					res = vorr(res, vclez(cnv));
+				lo += cnt;
+			}
+			if (!COUNT)
+				for (int n = 0; n < D; ++n)
+					if (res.v[n])
+						return 1;
+		}
+		return count;
+	}
+	bool bad()
+	{
+		return unsatisfied<false>();
+	}
+	template <typename STATS>
+	bool check(int iteration, STATS &stats)
+	{
+		if (!STATS::ENABLED)
+			return bad();
+		int count = unsatisfied<true>();
+		stats.check(iteration, count);
+		return count;
+	}
+	// $bnl$ holds a message for every link
+	template <typename STATS>
+	void update(TYPE *bnl, STATS &stats)
+	{
+		Links links = this->links();
+		const int q = links.q, W = links.W;
+		const uint8_t *cnc = this->cnc;
+		const Loc *lo = loc;
+		int saturations = 0, clampings = 0;
+		TYPE *bl = bnl;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			int deg = cnt + 2;
+			for (int j = 0; j < W; ++j) {
+				TYPE mags[CNC+2], inps[CNC+2];
+				TYPE min0 = vdup<TYPE>(127);
+				TYPE min1 = vdup<TYPE>(127);
+				TYPE signs = vdup<TYPE>(127);
+
+				for (int k = 0; k < deg; ++k) {
+					TYPE inp = vqsub(links.get(lo, i, j, k, cnt), bl[k]);
+
+					TYPE mag = vqabs(inp);
+
+					if (BETA) {
+						auto beta = vunsigned(vdup<TYPE>(BETA));
+						mag = vsigned(vqsub(vunsigned(mag), beta));
+					}
+
+					min1 = vmin(min1, vmax(min0, mag));
+					min0 = vmin(min0, mag);
+
+					signs = eor(signs, inp);
+
+					inps[k] = inp;
+					mags[k] = mag;
+				}
+				wd_t &mask = wd[W*i+j];
+				for (int k = 0; k < deg; ++k) {
+					TYPE mag = mags[k];
+					TYPE inp = inps[k];
+
+					TYPE out = vsign(other(mag, min0, min1), mine(signs, inp));
+
+					if (STATS::ENABLED)
+						clampings += lanes(vcgt(vqabs(out), vdup<TYPE>(31)));
+
+					out = vclamp(out, -31, 31);
+
+					out = selfcorr(bl[k], out);
+
+					TYPE tmp = vqadd(inp, out);
+
+					if (k < cnt && (mask >> k) & 1)
+						continue;
+
+					if (STATS::ENABLED)
+						saturations += lanes(vceq(vqabs(tmp), vdup<TYPE>(127)));
+
+					bl[k] = out;
+					links.set(lo, i, j, k, cnt, tmp);
+				}
+				advance(mask, lo, cnt);
+				lo += cnt;
+				bl += deg;
+			}
+		}
+		stats.update(saturations, clampings);
+	}
+	// $bnls$ vectors of $bnl$ are in use by the current code
+	template <typename STATS>
+	int decode(TYPE *bnl, int bnls, int trials, STATS &stats)
+	{
+		int total = trials;
+		stats.begin();
+		for (int i = 0; i < bnls; ++i)
+			bnl[i] = vzero<TYPE>();
+		for (int iter = 0; check(iter, stats) && --trials >= 0; ++iter)
+			update(bnl, stats);
+		stats.end(trials < 0 ? -1 : total - trials);
+		return trials;
+	}
+};
+
+}
+
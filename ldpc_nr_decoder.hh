@@ -0,0 +1,198 @@
+/*
+LDPC SISO layered decoder for the quasi-cyclic codes of 5G NR
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <cstring>
+#include <algorithm>
+#include "simd.hh"
+#include "ldpc_nr_lifting.hh"
+
+namespace CODE {
+
+template <typename TABLE, int BETA>
+class LDPCNRDecoder
+{
+	// constexpr, as std::min() takes it by reference
+#ifdef __AVX2__
+	static constexpr int SIMD_SIZE = 32;
+#else
+	static constexpr int SIMD_SIZE = 16;
+#endif
+	static const int ROWS = TABLE::ROWS;
+	static const int COLS = TABLE::COLS;
+	static const int LINKS = TABLE::LINKS;
+	static const int CNC = TABLE::DEG_MAX;
+	static const int Z_MAX = LDPCNRLifting::Z_MAX;
+	static const int CHUNKS = (Z_MAX + SIMD_SIZE - 1) / SIMD_SIZE;
+	// behind every column is a copy of its first $SIMD\_SIZE$ values, so any rotation is a single load
+	static const int STRIDE = Z_MAX + SIMD_SIZE;
+
+	typedef SIMD<int8_t, SIMD_SIZE> TYPE;
+
+	TYPE bnl[LINKS * CHUNKS];
+	int8_t var[COLS * STRIDE];
+	uint16_t shi[LINKS];
+	int Z;
+
+	static TYPE eor(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(veor(vmask(a), vmask(b)));
+	}
+	static TYPE orr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vorr(vmask(a), vmask(b)));
+	}
+	static TYPE other(TYPE a, TYPE b, TYPE c)
+	{
+		return vreinterpret<TYPE>(vbsl(vceq(a, b), vmask(c), vmask(b)));
+	}
+	static TYPE mine(TYPE a, TYPE b)
+	{
+		return orr(eor(a, b), vdup<TYPE>(127));
+	}
+	static TYPE selfcorr(TYPE a, TYPE b)
+	{
+		return vreinterpret<TYPE>(vand(vmask(b), vorr(vceqz(a), veor(vcgtz(a), vcltz(b)))));
+	}
+	// lane $l$ gets value $(o + l) \bmod Z$ of column $c$
+	TYPE load(int c, int o)
+	{
+		TYPE a;
+		std::memcpy(a.v, var + STRIDE * c + o, SIMD_SIZE);
+		return a;
+	}
+	// only the first $len$ lanes are written back, keeping the copy behind the column up to date
+	void store(int c, int o, TYPE a, int len)
+	{
+		int8_t *col = var + STRIDE * c;
+		if (len == SIMD_SIZE && o + SIMD_SIZE <= Z) {
+			std::memcpy(col + o, a.v, SIMD_SIZE);
+			for (int k = o; k < SIMD_SIZE; ++k)
+				col[Z + k] = col[k];
+		} else {
+			for (int l = 0; l < len; ++l) {
+				int p = o + l;
+				if (p >= Z)
+					p -= Z;
+				for (int k = p; k < Z + SIMD_SIZE; k += Z)
+					col[k] = a.v[l];
+			}
+		}
+	}
+	bool bad()
+	{
+		const int *ps = TABLE::POS;
+		const uint16_t *sh = shi;
+		for (int r = 0; r < ROWS; ++r) {
+			int deg = TABLE::DEG[r];
+			for (int z = 0; z < Z; z += SIMD_SIZE) {
+				TYPE cnv = vdup<TYPE>(1);
+				for (int k = 0; k < deg; ++k) {
+					int o = z + sh[k];
+					if (o >= Z)
+						o -= Z;
+					cnv = vsign(cnv, load(ps[k], o));
+				}
+				auto res = vclez(cnv);
+				int len = std::min(SIMD_SIZE, Z - z);
+				for (int l = 0; l < len; ++l)
+					if (res.v[l])
+						return true;
+			}
+			ps += deg;
+			sh += deg;
+		}
+		return false;
+	}
+	void update()
+	{
+		TYPE *bl = bnl;
+		const int *ps = TABLE::POS;
+		const uint16_t *sh = shi;
+		for (int r = 0; r < ROWS; ++r) {
+			int deg = TABLE::DEG[r];
+			// check node $z$ of this row links to value $(z + shift) \bmod Z$ of each of its columns
+			for (int z = 0; z < Z; z += SIMD_SIZE) {
+				TYPE mags[CNC], inps[CNC];
+				TYPE min0 = vdup<TYPE>(127);
+				TYPE min1 = vdup<TYPE>(127);
+				TYPE signs = vdup<TYPE>(127);
+				int offs[CNC];
+
+				for (int k = 0; k < deg; ++k) {
+					int o = z + sh[k];
+					if (o >= Z)
+						o -= Z;
+					offs[k] = o;
+
+					TYPE inp = vqsub(load(ps[k], o), bl[k]);
+
+					TYPE mag = vqabs(inp);
+
+					if (BETA) {
+						auto beta = vunsigned(vdup<TYPE>(BETA));
+						mag = vsigned(vqsub(vunsigned(mag), beta));
+					}
+
+					min1 = vmin(min1, vmax(min0, mag));
+					min0 = vmin(min0, mag);
+
+					signs = eor(signs, inp);
+
+					inps[k] = inp;
+					mags[k] = mag;
+				}
+				int len = std::min(SIMD_SIZE, Z - z);
+				for (int k = 0; k < deg; ++k) {
+					TYPE mag = mags[k];
+					TYPE inp = inps[k];
+
+					TYPE out = vsign(other(mag, min0, min1), mine(signs, inp));
+
+					out = vclamp(out, -31, 31);
+
+					out = selfcorr(bl[k], out);
+
+					bl[k] = out;
+					store(ps[k], offs[k], vqadd(inp, out), len);
+				}
+				bl += deg;
+			}
+			ps += deg;
+			sh += deg;
+		}
+	}
+public:
+	// $code$ has $COLS \cdot Z$ values, punctured ones should be zero
+	int operator()(int8_t *code, int Z, int trials = 25)
+	{
+		int set = LDPCNRLifting::set(Z);
+		assert(set >= 0);
+		this->Z = Z;
+		for (int e = 0; e < LINKS; ++e)
+			shi[e] = TABLE::SHI[set][e] % Z;
+		int chunks = (Z + SIMD_SIZE - 1) / SIMD_SIZE;
+		for (int i = 0; i < LINKS * chunks; ++i)
+			bnl[i] = vzero<TYPE>();
+		for (int c = 0; c < COLS; ++c) {
+			int8_t *col = var + STRIDE * c;
+			for (int z = 0; z < Z; ++z)
+				col[z] = code[Z*c+z];
+			for (int k = 0; k < SIMD_SIZE; ++k)
+				col[Z + k] = col[k % Z];
+		}
+		while (bad() && --trials >= 0)
+			update();
+		for (int c = 0; c < COLS; ++c)
+			for (int z = 0; z < Z; ++z)
+				code[Z*c+z] = var[STRIDE*c+z];
+		return trials;
+	}
+};
+
+}
+
@@ -0,0 +1,117 @@
+/*
+LDPC SISO encoder for the quasi-cyclic codes of 5G NR
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "ldpc_nr_lifting.hh"
+
+namespace CODE {
+
+template <typename TABLE>
+class LDPCNREncoder
+{
+	static const int ROWS = TABLE::ROWS;
+	static const int COLS = TABLE::COLS;
+	static const int LINKS = TABLE::LINKS;
+	static const int KB = COLS - ROWS;
+	static const int Z_MAX = LDPCNRLifting::Z_MAX;
+
+	int8_t acc[Z_MAX];
+	uint8_t poly[Z_MAX];
+	uint16_t first[ROWS];
+	int8_t unknown[ROWS];
+	int core;
+
+	// $acc_z = acc_z \cdot col_{(z + s) \bmod Z}$
+	static void mul(int8_t *acc, const int8_t *col, int s, int Z)
+	{
+		for (int z = 0; z < Z - s; ++z)
+			acc[z] *= col[z + s];
+		for (int z = Z - s; z < Z; ++z)
+			acc[z] *= col[z + s - Z];
+	}
+public:
+	LDPCNREncoder()
+	{
+		int deg[COLS];
+		for (int c = 0; c < COLS; ++c)
+			deg[c] = 0;
+		for (int e = 0; e < LINKS; ++e)
+			++deg[TABLE::POS[e]];
+		// the core parity columns are the only ones linked to more than one row
+		core = 0;
+		while (KB + core < COLS && deg[KB + core] > 1)
+			++core;
+		assert(core < ROWS);
+		// the sum of the core rows gives us the first parity column, after that every row adds at most one more
+		bool known[COLS];
+		for (int c = 0; c < COLS; ++c)
+			known[c] = c <= KB;
+		for (int r = 0, e = 0; r < ROWS; e += TABLE::DEG[r++]) {
+			first[r] = e;
+			unknown[r] = -1;
+			for (int d = 0; d < TABLE::DEG[r]; ++d) {
+				if (!known[TABLE::POS[e+d]]) {
+					assert(unknown[r] < 0);
+					unknown[r] = d;
+				}
+			}
+			if (unknown[r] >= 0)
+				known[TABLE::POS[e+unknown[r]]] = true;
+		}
+		for (int c = 0; c < COLS; ++c)
+			assert(known[c]);
+	}
+	// $code$ has $COLS \cdot Z$ bits, we fill in the last $ROWS \cdot Z$ of them
+	void operator()(int8_t *code, int Z)
+	{
+		int set = LDPCNRLifting::set(Z);
+		assert(set >= 0);
+		const int *shi = TABLE::SHI[set];
+		// the other core parity columns cancel out, leaving a single rotation of the first one
+		for (int z = 0; z < Z; ++z)
+			acc[z] = 1;
+		for (int z = 0; z < Z; ++z)
+			poly[z] = 0;
+		for (int e = 0; e < first[core]; ++e) {
+			int c = TABLE::POS[e], s = shi[e] % Z;
+			if (c < KB)
+				mul(acc, code + Z * c, s, Z);
+			else if (c == KB)
+				poly[s] ^= 1;
+		}
+		int t = -1;
+		for (int z = 0; z < Z; ++z) {
+			if (poly[z]) {
+				assert(t < 0);
+				t = z;
+			}
+		}
+		assert(t >= 0);
+		int8_t *p0 = code + Z * KB;
+		for (int w = 0; w < Z; ++w)
+			p0[w] = acc[(w - t + Z) % Z];
+		for (int r = 0; r < ROWS; ++r) {
+			if (unknown[r] < 0)
+				continue;
+			int e = first[r], u = e + unknown[r];
+			for (int z = 0; z < Z; ++z)
+				acc[z] = 1;
+			for (int d = 0; d < TABLE::DEG[r]; ++d)
+				if (e + d != u)
+					mul(acc, code + Z * TABLE::POS[e+d], shi[e+d] % Z, Z);
+			int8_t *col = code + Z * TABLE::POS[u];
+			int s = shi[u] % Z;
+			for (int z = 0; z < Z - s; ++z)
+				col[z + s] = acc[z];
+			for (int z = Z - s; z < Z; ++z)
+				col[z + s - Z] = acc[z];
+		}
+	}
+};
+
+}
+
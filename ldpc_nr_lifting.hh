@@ -0,0 +1,28 @@
+/*
+Lifting sizes of the quasi-cyclic LDPC codes used by 5G NR
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+namespace CODE {
+
+struct LDPCNRLifting
+{
+	static const int SETS = 8;
+	static const int Z_MAX = 384;
+	// every lifting size is $Z = a \cdot 2^j$ with $a$ picking the set of shift values
+	static int set(int Z)
+	{
+		static const int a[SETS] = { 2, 3, 5, 7, 9, 11, 13, 15 };
+		for (int s = 0; s < SETS; ++s)
+			for (int z = a[s]; z <= Z_MAX; z *= 2)
+				if (z == Z)
+					return s;
+		return -1;
+	}
+};
+
+}
+
@@ -0,0 +1,153 @@
+/*
+LDPC encoder working on packed bits
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+namespace CODE {
+
+template <typename TABLE>
+class LDPCPackedEncoder
+{
+	static const int M = TABLE::M;
+	static const int N = TABLE::N;
+	static const int K = TABLE::K;
+	static const int R = N-K;
+	static const int q = R/M;
+	static const int G = K/M;
+	// a block of M bits, first bit in the most significant bit of the first word
+	static const int WORDS = (M + 63) / 64;
+	static const int ROWS = (q + 63) / 64;
+	static const int ADDR = (TABLE::LINKS_TOTAL - (2*R-1)) / M;
+	static_assert(M % 8 == 0, "M must be multiple of eight");
+
+	uint16_t row[ADDR], shift[ADDR];
+	uint8_t deg[G];
+	uint64_t acc[q][WORDS];
+
+	static void load(uint64_t *out, const uint8_t *buf)
+	{
+		for (int w = 0; w < WORDS; ++w)
+			out[w] = 0;
+		for (int i = 0; i < M / 8; ++i)
+			out[i/8] |= uint64_t(buf[i]) << (56 - 8 * (i % 8));
+	}
+	static void transpose(uint64_t *a)
+	{
+		// 64 by 64 bits, swapping ever smaller blocks
+		uint64_t m = 0x00000000FFFFFFFF;
+		for (int j = 32; j; j >>= 1, m ^= m << j) {
+			for (int k = 0; k < 64; k = (k + j + 1) & ~j) {
+				uint64_t t = (a[k] ^ (a[k+j] >> j)) & m;
+				a[k] ^= t;
+				a[k+j] ^= t << j;
+			}
+		}
+	}
+	static uint64_t extract(const uint64_t *buf, int pos)
+	{
+		int w = pos / 64, b = pos % 64;
+		if (!b)
+			return buf[w];
+		return (buf[w] << b) | (buf[w+1] >> (64 - b));
+	}
+public:
+	LDPCPackedEncoder()
+	{
+		// the message bit $t$ of group $g$ goes to parity accumulator $q \cdot ((m + t) \bmod M) + n$
+		int a = 0;
+		const int *row_ptr = TABLE::POS;
+		for (int g = 0, l = 0; TABLE::LEN[l]; ++l) {
+			for (int r = 0; r < TABLE::LEN[l]; ++r, ++g) {
+				deg[g] = TABLE::DEG[l];
+				for (int d = 0; d < deg[g]; ++d, ++a) {
+					row[a] = row_ptr[d] % q;
+					shift[a] = row_ptr[d] / q;
+				}
+				row_ptr += deg[g];
+			}
+		}
+	}
+	// bits are packed with the first bit in the most significant bit of the first byte
+	void operator()(const uint8_t *data, uint8_t *parity)
+	{
+		for (int i = 0; i < q; ++i)
+			for (int w = 0; w < WORDS; ++w)
+				acc[i][w] = 0;
+		const uint16_t *ro = row, *sh = shift;
+		for (int g = 0; g < G; ++g) {
+			// two copies back to back, so any rotation is a window into them
+			uint64_t blk[WORDS], dbl[2*WORDS+1];
+			load(blk, data + g * (M / 8));
+			for (int w = 0; w < 2*WORDS+1; ++w)
+				dbl[w] = 0;
+			for (int w = 0; w < WORDS; ++w) {
+				dbl[w] |= blk[w];
+				dbl[w + M/64] |= blk[w] >> (M % 64);
+				if (M % 64)
+					dbl[w + M/64 + 1] |= blk[w] << (64 - M % 64);
+			}
+			for (int d = 0; d < deg[g]; ++d) {
+				// rotating by $m$ moves bit $t$ to $(m + t) \bmod M$
+				int pos = (M - sh[d]) % M;
+				uint64_t *a = acc[ro[d]];
+				for (int w = 0; w < WORDS; ++w)
+					a[w] ^= extract(dbl, pos + 64 * w);
+			}
+			ro += deg[g];
+			sh += deg[g];
+		}
+		// accumulator $q \cdot j + i$ is bit $j$ of row $i$, the prefix sum runs over $i$ first and then over $j$
+		for (int i = 1; i < q; ++i)
+			for (int w = 0; w < WORDS; ++w)
+				acc[i][w] ^= acc[i-1][w];
+		uint64_t carry[WORDS], par = 0;
+		for (int w = 0; w < WORDS; ++w) {
+			uint64_t x = acc[q-1][w];
+			if (w == WORDS-1 && M % 64)
+				x &= ~uint64_t(0) << (64 - M % 64);
+			uint64_t y = x;
+			y ^= y >> 1;
+			y ^= y >> 2;
+			y ^= y >> 4;
+			y ^= y >> 8;
+			y ^= y >> 16;
+			y ^= y >> 32;
+			// exclusive prefix of the bits before
+			carry[w] = (y ^ x) ^ -par;
+			par ^= y & 1;
+		}
+		for (int i = 0; i < q; ++i)
+			for (int w = 0; w < WORDS; ++w)
+				acc[i][w] ^= carry[w];
+		// transposed, column $j$ of the accumulators becomes a run of $q$ parity bits
+		uint64_t out = 0;
+		int cnt = 0;
+		auto append = [&](uint64_t bits, int n) {
+			while (n > 0) {
+				int m = n < 32 ? n : 32;
+				out = (out << m) | (bits >> (64 - m));
+				bits <<= m;
+				n -= m;
+				for (cnt += m; cnt >= 8; cnt -= 8)
+					*parity++ = out >> (cnt - 8);
+			}
+		};
+		for (int w = 0; w < WORDS; ++w) {
+			uint64_t blk[ROWS][64];
+			for (int r = 0; r < ROWS; ++r) {
+				for (int i = 0; i < 64; ++i)
+					blk[r][i] = 64 * r + i < q ? acc[64*r+i][w] : 0;
+				transpose(blk[r]);
+			}
+			for (int c = 0; c < 64 && 64 * w + c < M; ++c)
+				for (int r = 0; r < ROWS; ++r)
+					append(blk[r][c], q - 64 * r < 64 ? q - 64 * r : 64);
+		}
+	}
+};
+
+}
+
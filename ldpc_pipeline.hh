@@ -0,0 +1,115 @@
+/*
+LDPC frame decoding on a pool of threads, delivering results in order
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "ldpc_decoder.hh"
+
+namespace CODE {
+
+template <typename TABLE, int BETA>
+class LDPCPipeline
+{
+	static const int K = TABLE::K;
+	typedef LDPCDecoder<TABLE, BETA> DECODER;
+	struct Slot
+	{
+		int8_t *code;
+		int result;
+		std::atomic<bool> done;
+	};
+	Slot *slots;
+	int capacity, trials;
+	// frames $[tail, head)$ are in flight, workers take them in order from $next$
+	// these only ever count up, 64 bits last for centuries at any frame rate
+	std::atomic<uint64_t> head, next, tail;
+	std::atomic<bool> stop;
+	std::vector<DECODER *> decoders;
+	std::vector<std::thread> workers;
+
+	static void idle(int &spins)
+	{
+		// don't burn a core while there is nothing to do
+		if (++spins < 64)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+	void work(DECODER *decode)
+	{
+		int spins = 0;
+		while (!stop.load(std::memory_order_relaxed)) {
+			uint64_t i = next.load(std::memory_order_relaxed);
+			// whoever is idle takes the next frame, so slow frames don't hold up the other threads
+			if (i == head.load(std::memory_order_acquire) || !next.compare_exchange_weak(i, i + 1, std::memory_order_relaxed)) {
+				idle(spins);
+				continue;
+			}
+			spins = 0;
+			Slot &slot = slots[i % capacity];
+			slot.result = (*decode)(slot.code, slot.code + K, trials);
+			slot.done.store(true, std::memory_order_release);
+		}
+	}
+public:
+	LDPCPipeline(int threads, int capacity = 64, int trials = 25) :
+		capacity(capacity), trials(trials), head(0), next(0), tail(0), stop(false)
+	{
+		assert(threads > 0 && capacity > 0);
+		slots = new Slot[capacity];
+		for (int i = 0; i < capacity; ++i)
+			slots[i].done = false;
+		for (int t = 0; t < threads; ++t)
+			decoders.push_back(new DECODER());
+		for (int t = 0; t < threads; ++t)
+			workers.emplace_back(&LDPCPipeline::work, this, decoders[t]);
+	}
+	~LDPCPipeline()
+	{
+		stop = true;
+		for (auto &thread: workers)
+			thread.join();
+		for (auto decoder: decoders)
+			delete decoder;
+		delete[] slots;
+	}
+	// a single producer hands in frames of $N$ LLRs, they get decoded in place
+	void push(int8_t *code)
+	{
+		uint64_t i = head.load(std::memory_order_relaxed);
+		for (int spins = 0; i - tail.load(std::memory_order_acquire) >= uint64_t(capacity);)
+			idle(spins);
+		slots[i % capacity].code = code;
+		head.store(i + 1, std::memory_order_release);
+	}
+	// a single consumer gets them back in the order they were pushed, with what the decoder returned
+	int8_t *pop(int *result = 0)
+	{
+		uint64_t i = tail.load(std::memory_order_relaxed);
+		assert(i != head.load(std::memory_order_relaxed));
+		Slot &slot = slots[i % capacity];
+		for (int spins = 0; !slot.done.load(std::memory_order_acquire);)
+			idle(spins);
+		int8_t *code = slot.code;
+		if (result)
+			*result = slot.result;
+		slot.done.store(false, std::memory_order_relaxed);
+		tail.store(i + 1, std::memory_order_release);
+		return code;
+	}
+	// frames pushed but not popped yet
+	int pending()
+	{
+		return int(head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed));
+	}
+};
+
+}
+
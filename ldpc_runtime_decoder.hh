@@ -0,0 +1,42 @@
+/*
+LDPC SISO layered decoder with code tables chosen at runtime
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "ldpc_kernel.hh"
+
+namespace CODE {
+
+// one decoder for all codes up to $MAX\_N$ bits and $MAX\_LINKS$ links, switching codes costs nothing
+template <int BETA, int MAX_N, int MAX_LINKS, typename STATS = LDPCNoStats>
+class LDPCRuntimeDecoder
+{
+	typedef LDPCRuntimeTable TABLE;
+	static const int D = TABLE::D;
+	static const int BNL = (MAX_LINKS + D) / D;
+	static const int VAR = MAX_N / D;
+	typedef LDPCKernel<BETA, VAR, VAR> KERNEL;
+	typedef typename KERNEL::TYPE TYPE;
+
+	KERNEL kernel;
+	TYPE bnl[BNL];
+public:
+	// only collects anything if STATS isn't the default LDPCNoStats
+	STATS stats;
+
+	int operator()(const TABLE *code, int8_t *message, int8_t *parity, int trials = 25)
+	{
+		assert(code->BNL <= BNL);
+		kernel.reset(*code);
+		kernel.load(message, parity);
+		trials = kernel.decode(bnl, code->BNL, trials, stats);
+		kernel.store(message, parity);
+		return trials;
+	}
+};
+
+}
+
@@ -0,0 +1,96 @@
+/*
+Connectivity of LDPC codes, parsed at runtime
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+namespace CODE {
+
+// connectivity of one code, parsed from the same DEG, LEN and POS tables LDPCDecoder takes
+class LDPCRuntimeTable
+{
+public:
+#ifdef __AVX2__
+	// M = 360 = 30 * 12
+	static const int WORD_SIZE = 30;
+#else
+	// M = 360 = 15 * 24
+	static const int WORD_SIZE = 15;
+#endif
+	static const int D = WORD_SIZE;
+	typedef struct { uint16_t off; uint16_t shi; } Loc;
+	typedef uint32_t wd_t;
+	static const int CNC_MAX = sizeof(wd_t) * 8;
+	int M, N, K, q, W, CNC, BNL;
+	std::vector<uint8_t> cnc;
+	std::vector<Loc> loc;
+	std::vector<wd_t> wd;
+	LDPCRuntimeTable(int M, int N, int K, const int *DEG, const int *LEN, const int *POS) :
+		M(M), N(N), K(K), q((N-K)/M), W(M/D), CNC(0), BNL(0), cnc(q)
+	{
+		assert(M % D == 0 && K % M == 0 && (N-K) % M == 0);
+		std::vector<int> count(q);
+		const int *row_ptr = POS;
+		for (int g = 0; LEN[g]; ++g)
+			for (int r = 0; r < LEN[g]; ++r)
+				for (int d = 0; d < DEG[g]; ++d)
+					++count[*row_ptr++ % q];
+		for (int i = 0; i < q; ++i)
+			CNC = std::max(CNC, count[i]);
+		assert(CNC <= CNC_MAX);
+		std::vector<uint16_t> pos(q * CNC);
+		int bit_pos = 0;
+		row_ptr = POS;
+		for (int g = 0; LEN[g]; ++g) {
+			int bit_deg = DEG[g];
+			for (int r = 0; r < LEN[g]; ++r) {
+				for (int d = 0; d < bit_deg; ++d) {
+					int n = row_ptr[d] % q;
+					int m = row_ptr[d] / q;
+					pos[CNC*n+cnc[n]++] = bit_pos + (M - m) % M;
+				}
+				row_ptr += bit_deg;
+				bit_pos += M;
+			}
+		}
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			int offset[CNC_MAX], shift[CNC_MAX];
+			for (int c = 0; c < cnt; ++c) {
+				shift[c] = pos[CNC*i+c] % M;
+				offset[c] = pos[CNC*i+c] - shift[c];
+			}
+			for (int j = 0; j < W; ++j) {
+				Loc *lo = &*loc.insert(loc.end(), cnt, Loc());
+				for (int c = 0; c < cnt; ++c) {
+					lo[c].off = offset[c] / D + shift[c] % W;
+					lo[c].shi = shift[c] / W;
+					shift[c] = (shift[c] + 1) % M;
+				}
+				std::sort(lo, lo + cnt, [](const Loc &a, const Loc &b){ return a.off < b.off; });
+				wd_t mask = 0;
+				for (int c = 0; c < cnt-1; ++c)
+					if (lo[c].off == lo[c+1].off)
+						mask |= 1 << c;
+				wd.push_back(mask);
+			}
+			BNL += W * (cnt + 2);
+		}
+	}
+};
+
+// parsed by the first decoder that needs it and shared read-only by all decoders of that TABLE
+template <typename TABLE>
+const LDPCRuntimeTable &ldpc_layout()
+{
+	static const LDPCRuntimeTable table(TABLE::M, TABLE::N, TABLE::K, TABLE::DEG, TABLE::LEN, TABLE::POS);
+	return table;
+}
+
+}
+
@@ -0,0 +1,128 @@
+/*
+Statistics collectors for the LDPC decoder
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <chrono>
+#include <ostream>
+
+namespace CODE {
+
+// the default, everything here compiles to nothing
+struct LDPCNoStats
+{
+	static const bool ENABLED = false;
+	void begin() {}
+	void check(int, int) {}
+	void update(int, int) {}
+	void end(int) {}
+};
+
+// bin $0$ counts zeros, bin $b > 0$ counts values in $[2^{b-1}, 2^b)$
+template <int BINS>
+struct LDPCHistogram
+{
+	uint64_t bin[BINS];
+	void reset()
+	{
+		for (int b = 0; b < BINS; ++b)
+			bin[b] = 0;
+	}
+	void add(uint64_t value)
+	{
+		int b = 0;
+		while (value && b < BINS - 1) {
+			value >>= 1;
+			++b;
+		}
+		++bin[b];
+	}
+	// one "name [index] lower_bound count" line for every non-empty bin
+	void write(std::ostream &os, const char *name, int index = -1) const
+	{
+		for (int b = 0; b < BINS; ++b) {
+			if (bin[b]) {
+				os << name << " ";
+				if (index >= 0)
+					os << index << " ";
+				os << (b ? uint64_t(1) << (b - 1) : 0) << " " << bin[b] << std::endl;
+			}
+		}
+	}
+};
+
+template <int MAX_ITERATIONS>
+struct LDPCStats
+{
+	static const bool ENABLED = true;
+	static const int BINS = 32;
+	uint64_t frames, failures;
+	// how many frames converged after this many iterations
+	uint64_t iterations[MAX_ITERATIONS + 1];
+	// unsatisfied check nodes seen before the update of that iteration
+	LDPCHistogram<BINS> unsatisfied[MAX_ITERATIONS + 1];
+	// values stuck at $\pm 127$ and check node messages cut to $\pm 31$ per update
+	LDPCHistogram<BINS> saturated, clamped;
+	LDPCHistogram<BINS> microseconds;
+	std::chrono::steady_clock::time_point start;
+
+	LDPCStats()
+	{
+		reset();
+	}
+	void reset()
+	{
+		frames = failures = 0;
+		for (int i = 0; i <= MAX_ITERATIONS; ++i) {
+			iterations[i] = 0;
+			unsatisfied[i].reset();
+		}
+		saturated.reset();
+		clamped.reset();
+		microseconds.reset();
+	}
+	void begin()
+	{
+		start = std::chrono::steady_clock::now();
+	}
+	void check(int iteration, int count)
+	{
+		if (iteration <= MAX_ITERATIONS)
+			unsatisfied[iteration].add(count);
+	}
+	void update(int saturations, int clampings)
+	{
+		saturated.add(saturations);
+		clamped.add(clampings);
+	}
+	// $iteration < 0$ if the decoder gave up
+	void end(int iteration)
+	{
+		auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+		microseconds.add(usec.count());
+		++frames;
+		if (iteration < 0)
+			++failures;
+		else if (iteration <= MAX_ITERATIONS)
+			++iterations[iteration];
+	}
+	void write(std::ostream &os) const
+	{
+		os << "frames " << frames << std::endl;
+		os << "failures " << failures << std::endl;
+		for (int i = 0; i <= MAX_ITERATIONS; ++i)
+			if (iterations[i])
+				os << "iterations " << i << " " << iterations[i] << std::endl;
+		for (int i = 0; i <= MAX_ITERATIONS; ++i)
+			unsatisfied[i].write(os, "unsatisfied", i);
+		saturated.write(os, "saturated");
+		clamped.write(os, "clamped");
+		microseconds.write(os, "microseconds");
+	}
+};
+
+}
+
@@ -0,0 +1,131 @@
+/*
+Spread independent loop iterations over a few threads
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+namespace CODE {
+
+// calls func(i) for $0 \le i < count$, in no particular order
+template <typename FUNC>
+void parallel_for(int count, int threads, FUNC func)
+{
+	if (threads > count)
+		threads = count;
+	if (threads < 2) {
+		for (int i = 0; i < count; ++i)
+			func(i);
+		return;
+	}
+	// iterations are handed out one at a time, so uneven work balances itself
+	std::atomic<int> next(0);
+	auto work = [&]() {
+		for (int i = next++; i < count; i = next++)
+			func(i);
+	};
+	std::vector<std::thread> pool;
+	for (int t = 1; t < threads; ++t)
+		pool.emplace_back(work);
+	work();
+	for (auto &thread: pool)
+		thread.join();
+}
+
+// the same as parallel_for, but the threads are started once and wait for work between calls
+class ParallelPool
+{
+	std::vector<std::thread> pool;
+	std::mutex mutex;
+	std::condition_variable wake, done;
+	void (*call)(void *, int);
+	void *func;
+	std::atomic<int> next;
+	int count, generation, busy;
+	bool stop;
+
+	void work()
+	{
+		for (int i = next++; i < count; i = next++)
+			call(func, i);
+	}
+	void loop()
+	{
+		int seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			wake.wait(lock, [&]{ return stop || generation != seen; });
+			if (stop)
+				return;
+			seen = generation;
+			lock.unlock();
+			work();
+			lock.lock();
+			if (!--busy)
+				done.notify_one();
+		}
+	}
+public:
+	ParallelPool(int threads) : next(0), count(0), generation(0), busy(0), stop(false)
+	{
+		// the calling thread is one of them
+		for (int t = 1; t < threads; ++t)
+			pool.emplace_back(&ParallelPool::loop, this);
+	}
+	~ParallelPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		wake.notify_all();
+		for (auto &thread: pool)
+			thread.join();
+	}
+	// calls func(i) for $0 \le i < count$, in no particular order, and returns when all of them are done
+	template <typename FUNC>
+	void operator()(int count, FUNC func)
+	{
+		if (pool.empty() || count < 2) {
+			for (int i = 0; i < count; ++i)
+				func(i);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			call = [](void *f, int i) { (*static_cast<FUNC *>(f))(i); };
+			this->func = &func;
+			this->count = count;
+			next = 0;
+			busy = pool.size();
+			++generation;
+		}
+		wake.notify_all();
+		work();
+		// func lives on our stack, so wait for the stragglers
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [&]{ return !busy; });
+	}
+};
+
+// without a pool everything runs on the calling thread
+template <typename FUNC>
+void parallel_for(int count, ParallelPool *pool, FUNC func)
+{
+	if (pool) {
+		(*pool)(count, func);
+		return;
+	}
+	for (int i = 0; i < count; ++i)
+		func(i);
+}
+
+}
+
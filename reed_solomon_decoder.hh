@@ -10,7 +10,7 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 
 namespace CODE {
 
-template <int ROOTS, int FCR, typename GF>
+template <int ROOTS, int FCR, typename GF, template <int, typename> class KES = RS::BerlekampMassey>
 class ReedSolomonDecoder
 {
 public:
@@ -20,28 +20,77 @@ public:
 	static const int NR = ROOTS;
 	static const int N = GF::N, K = N - NR, NP = NR;
 private:
-	ReedSolomonErrorCorrection<NR, FCR, GF> algorithm;
-	void update_syndromes(const ValueType *poly, ValueType *syndromes, int begin, int end)
+	ReedSolomonErrorCorrection<NR, FCR, GF, KES> algorithm;
+	static const int B = 64;
+	// $step_i = pe^{(FCR+i)B}$
+	ConstantMultiply<GF> step[NR];
+	int correct(ValueType *data, ValueType *parity, int data_len)
 	{
-		for (int j = begin; j < end; ++j) {
-			ValueType coeff(poly[j]);
-			IndexType root(FCR), pe(1);
-			for (int i = 0; i < NR; ++i) {
-				syndromes[i] = fma(root, syndromes[i], coeff);
-				root *= pe;
-			}
+		ValueType syndromes[NR];
+		if (!compute_syndromes(data, parity, syndromes, data_len))
+			return 0;
+		IndexType locations[NR];
+		ValueType magnitudes[NR];
+		int count = algorithm.prepared(syndromes, locations, magnitudes, data_len + NP);
+		return apply(data, parity, locations, magnitudes, count, data_len);
+	}
+	static int apply(ValueType *data, ValueType *parity, const IndexType *locations, const ValueType *magnitudes, int count, int data_len)
+	{
+		if (count <= 0)
+			return count;
+		for (int i = 0; i < count; ++i)
+			if ((int)locations[i] < K - data_len)
+				return -1;
+		for (int i = 0; i < count; ++i) {
+			int idx = (int)locations[i] + data_len - K;
+			if (idx < data_len)
+				data[idx] += magnitudes[i];
+			else
+				parity[idx-data_len] += magnitudes[i];
 		}
+		int corrections_count = 0;
+		for (int i = 0; i < count; ++i)
+			corrections_count += !!magnitudes[i];
+		return corrections_count;
 	}
 public:
+	ReedSolomonDecoder()
+	{
+		for (int i = 0; i < NR; ++i)
+			step[i] = IndexType(((FCR + i) * B) % N);
+	}
 	int compute_syndromes(const ValueType *data, const ValueType *parity, ValueType *syndromes, int data_len = K)
 	{
 		assert(0 < data_len && data_len <= K);
 		// $syndromes_i = code(pe^{FCR+i})$
-		ValueType coeff(data[0]);
+		// evaluated B positions at a time: $acc_i = (acc_i + block) \cdot pe^{(FCR+i)B}$
+		int length = data_len + NP;
+		int first = length % B ? length % B - B : 0;
+		alignas(32) ValueType acc[NR][B];
 		for (int i = 0; i < NR; ++i)
-			syndromes[i] = coeff;
-		update_syndromes(data, syndromes, 1, data_len);
-		update_syndromes(parity, syndromes, 0, NP);
+			for (int b = 0; b < B; ++b)
+				acc[i][b] = ValueType(0);
+		for (int j = first; j < length; j += B) {
+			alignas(32) ValueType block[B];
+			for (int b = 0; b < B; ++b) {
+				int k = j + b;
+				block[b] = k < 0 ? ValueType(0) : k < data_len ? data[k] : parity[k-data_len];
+			}
+			for (int i = 0; i < NR; ++i) {
+				for (int b = 0; b < B; ++b)
+					acc[i][b].v ^= block[b].v;
+				step[i](acc[i], acc[i], B, true);
+			}
+		}
+		// $syndromes_i = \sum_b acc_{i,b} \cdot pe^{-(FCR+i)(b+1)}$
+		for (int i = 0; i < NR; ++i) {
+			IndexType root(FCR + i), tmp(rcp(root));
+			syndromes[i] = ValueType(0);
+			for (int b = 0; b < B; ++b) {
+				syndromes[i] += acc[i][b] * tmp;
+				tmp /= root;
+			}
+		}
 		int nonzero = 0;
 		for (int i = 0; i < NR; ++i)
 			nonzero += !!syndromes[i];
@@ -69,28 +118,35 @@ public:
 			return 0;
 		IndexType locations[NR];
 		ValueType magnitudes[NR];
-		int count = algorithm(syndromes, locations, magnitudes, erasures, erasures_count);
-		if (count <= 0)
-			return count;
-		for (int i = 0; i < count; ++i)
-			if ((int)locations[i] < K - data_len)
-				return -1;
-		for (int i = 0; i < count; ++i) {
-			int idx = (int)locations[i] + data_len - K;
-			if (idx < data_len)
-				data[idx] += magnitudes[i];
-			else
-				parity[idx-data_len] += magnitudes[i];
+		int count = algorithm(syndromes, locations, magnitudes, erasures, erasures_count, data_len + NP);
+		return apply(data, parity, locations, magnitudes, count, data_len);
+	}
+	int batch(ValueType *data, ValueType *parity, int blocks, const IndexType *erasures, int erasures_count, int *results = 0, int data_len = K)
+	{
+		// $blocks$ codewords stored back to back, all sharing the same erasures
+		assert(0 <= erasures_count && erasures_count <= NR);
+		assert(0 < data_len && data_len <= K);
+		IndexType shifted[NR];
+		for (int i = 0; i < erasures_count; ++i)
+			shifted[i] = IndexType((int)erasures[i] + K - data_len);
+		algorithm.prepare(shifted, erasures_count);
+		int failures = 0;
+		for (int b = 0; b < blocks; ++b) {
+			int ret = correct(data + b * data_len, parity + b * NP, data_len);
+			failures += ret < 0;
+			if (results)
+				results[b] = ret;
 		}
-		int corrections_count = 0;
-		for (int i = 0; i < count; ++i)
-			corrections_count += !!magnitudes[i];
-		return corrections_count;
+		return failures;
 	}
 	int operator()(value_type *data, value_type *parity, value_type *erasures = 0, int erasures_count = 0, int data_len = K)
 	{
 		return (*this)(reinterpret_cast<ValueType *>(data), reinterpret_cast<ValueType *>(parity), reinterpret_cast<IndexType *>(erasures), erasures_count, data_len);
 	}
+	int batch(value_type *data, value_type *parity, int blocks, const value_type *erasures, int erasures_count, int *results = 0, int data_len = K)
+	{
+		return batch(reinterpret_cast<ValueType *>(data), reinterpret_cast<ValueType *>(parity), blocks, reinterpret_cast<const IndexType *>(erasures), erasures_count, results, data_len);
+	}
 	int compute_syndromes(const value_type *data, const value_type *parity, value_type *syndromes, int data_len = K)
 	{
 		return compute_syndromes(reinterpret_cast<const ValueType *>(data), reinterpret_cast<const ValueType *>(parity), reinterpret_cast<ValueType *>(syndromes), data_len);
@@ -17,8 +17,10 @@ public:
 	typedef typename GF::IndexType IndexType;
 	static const int NR = ROOTS;
 	static const int N = GF::N, K = N - NR, NP = NR;
+	static const int NIBBLES = (GF::M + 3) / 4;
 private:
-	IndexType generator[NR+1];
+	// $rows_{n,a,j} = generator_{NR-1-j} \cdot (a \ll 4n)$
+	alignas(32) value_type rows[NIBBLES][16][NR];
 public:
 	ReedSolomonEncoder()
 	{
@@ -47,28 +49,31 @@ public:
 			}
 			std::cerr << (int)tmp[0] << std::endl;
 		}
-		for (int i = 0; i <= NR; ++i)
-			generator[i] = index(tmp[i]);
+		for (int n = 0; n < NIBBLES; ++n)
+			for (int a = 0; a < 16; ++a)
+				for (int j = 0; j < NR; ++j)
+					rows[n][a][j] = (a << 4*n) > N ? 0 : (tmp[NR-1-j] * ValueType(a << 4*n)).v;
 	}
 	void operator()(const ValueType *data, ValueType *parity, int data_len = K)
 	{
 		assert(0 < data_len && data_len <= K);
 		// $code = data * x^{NR} + (data * x^{NR}) \mod{generator}$
-		for (int i = 0; i < NR; ++i)
-			parity[i] = ValueType(0);
+		// multiplying the generator by the feedback is done nibble wise using the rows tables
+		alignas(32) value_type reg[NR+1];
+		for (int j = 0; j <= NR; ++j)
+			reg[j] = 0;
 		for (int i = 0; i < data_len; ++i) {
-			ValueType feedback = data[i] + parity[0];
-			if (feedback) {
-				IndexType fb = index(feedback);
-				for (int j = 1; j < NR; ++j)
-					parity[j-1] = fma(fb, generator[NR-j], parity[j]);
-				parity[NP-1] = value(generator[0] * fb);
-			} else {
-				for (int j = 1; j < NR; ++j)
-					parity[j-1] = parity[j];
-				parity[NP-1] = ValueType(0);
+			value_type fb = data[i].v ^ reg[0];
+			for (int j = 0; j < NR; ++j)
+				reg[j] = reg[j+1];
+			for (int n = 0; n < NIBBLES; ++n) {
+				const value_type *row = rows[n][(fb >> 4*n) & 15];
+				for (int j = 0; j < NR; ++j)
+					reg[j] ^= row[j];
 			}
 		}
+		for (int j = 0; j < NR; ++j)
+			parity[j] = ValueType(reg[j]);
 	}
 	void operator()(const value_type *data, value_type *parity, int data_len = K)
 	{
@@ -6,6 +6,9 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 
 #pragma once
 
+#include <algorithm>
+#include "constant_multiply.hh"
+
 namespace CODE {
 namespace RS {
 
@@ -14,18 +17,42 @@ struct Chien
 {
 	typedef typename GF::ValueType ValueType;
 	typedef typename GF::IndexType IndexType;
-	static int search(const ValueType *locator, int locator_degree, IndexType *locations)
+	static const int B = 64;
+	static int search(const ValueType *locator, int locator_degree, IndexType *locations, int length = GF::N)
 	{
-		ValueType tmp[NR+1];
-		for (int i = 0; i <= locator_degree; ++i)
-			tmp[i] = locator[i];
+		assert(0 <= locator_degree && locator_degree <= NR);
+		assert(0 < length && length <= GF::N);
+		// shortened codes can only have errors in the last length positions
+		int first = GF::N - length;
+		// $terms_{j,b} = locator_j \cdot pe^{j(first+b+1)}$
+		alignas(32) ValueType terms[NR+1][B];
+		ConstantMultiply<GF> step[NR+1];
+		for (int j = 1; j <= locator_degree; ++j) {
+			if (!locator[j])
+				continue;
+			for (int b = 0; b < B; ++b)
+				terms[j][b] = locator[j] * IndexType((j * (first + b + 1)) % GF::N);
+			step[j] = IndexType((j * B) % GF::N);
+		}
 		int count = 0;
-		for (int i = 0; i < GF::N; ++i) {
-			ValueType sum(tmp[0]);
+		for (int i = first; i < GF::N; i += B) {
+			ValueType sums[B];
+			for (int b = 0; b < B; ++b)
+				sums[b] = locator[0];
 			for (int j = 1; j <= locator_degree; ++j)
-				sum += tmp[j] *= IndexType(j);
-			if (!sum)
-				locations[count++] = IndexType(i);
+				if (locator[j])
+					for (int b = 0; b < B; ++b)
+						sums[b].v ^= terms[j][b].v;
+			for (int b = 0; b < B && i + b < GF::N; ++b) {
+				if (!sums[b]) {
+					locations[count++] = IndexType(i + b);
+					if (count == locator_degree)
+						return count;
+				}
+			}
+			for (int j = 1; j <= locator_degree; ++j)
+				if (locator[j])
+					step[j](terms[j], terms[j], B, true);
 		}
 		return count;
 	}
@@ -44,8 +71,6 @@ struct ArtinSchreier
 		for (int i = 2; i < GF::N; i += 2) {
 			ValueType x(i);
 			ValueType xxx(x * x + x);
-			if (xxx == ValueType(GF::N))
-				continue;
 			assert(xxx.v);
 			assert(!imap[xxx.v].v);
 			imap[xxx.v] = x;
@@ -58,13 +83,88 @@ struct ArtinSchreier
 	}
 };
 
+template <typename GF>
+struct ReducedCubic
+{
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	ValueType rmap[GF::Q];
+	ReducedCubic()
+	{
+		for (int i = 0; i < GF::Q; ++i)
+			rmap[i] = ValueType(0);
+		for (int i = 2; i < GF::Q; ++i) {
+			ValueType z(i);
+			ValueType zzz(z * z * z + z);
+			assert(zzz.v);
+			if (!rmap[zzz.v])
+				rmap[zzz.v] = z;
+		}
+	}
+	// $z^3 + z = r$
+	ValueType operator()(ValueType r) {
+		assert(r.v <= r.N);
+		assert(r.v);
+		return rmap[r.v];
+	}
+};
+
 template <int NR, typename GF>
 struct LocationFinder
 {
 	typedef typename GF::ValueType ValueType;
 	typedef typename GF::IndexType IndexType;
 	ArtinSchreier<GF> imap;
-	int operator()(const ValueType *locator, int locator_degree, IndexType *locations)
+	ReducedCubic<GF> rmap;
+	static IndexType sqrt(IndexType a)
+	{
+		return IndexType(a.i & 1 ? (a.i + GF::N) / 2 : a.i / 2);
+	}
+	// $x^2 + b\,x + c = 0$
+	bool quadratic(ValueType b, ValueType c, ValueType *roots)
+	{
+		if (!b || !c)
+			return false;
+		ValueType R(imap(c/(b*b)));
+		if (!R)
+			return false;
+		roots[0] = b * R;
+		roots[1] = roots[0] + b;
+		return true;
+	}
+	// one root of $x^3 + b\,x + c = 0$
+	ValueType cubic(ValueType b, ValueType c)
+	{
+		assert(c.v);
+		if (!b) {
+			int k = (int)index(c);
+			if (GF::N % 3)
+				k = (int64_t(k) * (GF::N % 3 == 1 ? (2 * GF::N + 1) / 3 : (GF::N + 1) / 3)) % GF::N;
+			else if (k % 3)
+				return ValueType(0);
+			else
+				k /= 3;
+			return value(IndexType(k));
+		}
+		// $x = \sqrt{b}\,z$
+		IndexType sb(sqrt(index(b)));
+		ValueType z(rmap(c / (sb * sb * sb)));
+		if (!z)
+			return z;
+		return z * sb;
+	}
+	// $x^4 + b\,x^2 + c\,x + d = 0$
+	bool quartic(ValueType b, ValueType c, ValueType d, ValueType *roots)
+	{
+		if (!c || !d)
+			return false;
+		// $(x^2 + s\,x + t)(x^2 + s\,x + u)$
+		ValueType s(cubic(b, c)), tu[2];
+		if (!s)
+			return false;
+		return quadratic(c/s, d, tu) && quadratic(s, tu[0], roots) && quadratic(s, tu[1], roots + 2);
+	}
+	int operator()(const ValueType *locator, int locator_degree, IndexType *locations, int length = GF::N)
 	{
 		if (locator_degree == 1) {
 			locations[0] = (index(locator[0]) / index(locator[1])) / IndexType(1);
@@ -81,7 +181,46 @@ struct LocationFinder
 			locations[1] = index(ba * R + ba) / IndexType(1);
 			return 2;
 		}
-		return Chien<NR, GF>::search(locator, locator_degree, locations);
+		if (locator_degree == 3) {
+			if (!locator[0])
+				return 0;
+			ValueType a(locator[2]/locator[3]), b(locator[1]/locator[3]), c(locator[0]/locator[3]);
+			// $x = y + a$
+			ValueType p(a * a + b), q(a * b + c), y[3];
+			if (!q)
+				return 0;
+			y[2] = cubic(p, q);
+			if (!y[2] || !quadratic(y[2], y[2] * y[2] + p, y))
+				return 0;
+			for (int i = 0; i < 3; ++i)
+				locations[i] = index(y[i] + a) / IndexType(1);
+			return 3;
+		}
+		if (locator_degree == 4) {
+			if (!locator[0])
+				return 0;
+			ValueType a(locator[3]/locator[4]), b(locator[2]/locator[4]), c(locator[1]/locator[4]), d(locator[0]/locator[4]);
+			ValueType z[4];
+			if (!a) {
+				if (!quartic(b, c, d, z))
+					return 0;
+				for (int i = 0; i < 4; ++i)
+					locations[i] = index(z[i]) / IndexType(1);
+				return 4;
+			}
+			// $x = y + e$ with $e = \sqrt{c/a}$ eliminates the linear term
+			ValueType e(!c ? c : value(sqrt(index(c/a))));
+			ValueType f((((e + a) * e + b) * e + c) * e + d);
+			if (!f)
+				return 0;
+			// $y = 1/z$ eliminates the cubic term
+			if (!quartic((a * e + b) / f, a / f, rcp(f), z))
+				return 0;
+			for (int i = 0; i < 4; ++i)
+				locations[i] = index(rcp(z[i]) + e) / IndexType(1);
+			return 4;
+		}
+		return Chien<NR, GF>::search(locator, locator_degree, locations, length);
 	}
 };
 
@@ -180,18 +319,64 @@ struct BerlekampMassey
 	}
 };
 
+template <int NR, typename GF>
+struct InversionlessBerlekampMassey
+{
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	static int algorithm(const ValueType *s, ValueType *C, int count = 0)
+	{
+		// $C$ ends up scaled by the product of the previous discrepancies
+		ValueType B[NR+1];
+		for (int i = 0; i <= NR; ++i)
+			B[i] = C[i];
+		ValueType g(1);
+		int L = count;
+		for (int n = count, m = 1; n < NR; ++n) {
+			ValueType d(C[0] * s[n]);
+			for (int i = 1; i <= L; ++i)
+				d += C[i] * s[n-i];
+			if (!d) {
+				++m;
+			} else {
+				ValueType T[NR+1];
+				for (int i = 0; i < m; ++i)
+					T[i] = g * C[i];
+				for (int i = m; i <= NR; ++i)
+					T[i] = fma(d, B[i-m], g * C[i]);
+				if (2 * L <= n + count) {
+					L = n + count + 1 - L;
+					for (int i = 0; i <= NR; ++i)
+						B[i] = C[i];
+					g = d;
+					m = 1;
+				} else {
+					++m;
+				}
+				for (int i = 0; i <= NR; ++i)
+					C[i] = T[i];
+			}
+		}
+		return L;
+	}
+};
+
 }
 
-template <int NR, int FCR, typename GF>
+template <int NR, int FCR, typename GF, template <int, typename> class KES = RS::BerlekampMassey>
 struct ReedSolomonErrorCorrection
 {
 	typedef typename GF::ValueType ValueType;
 	typedef typename GF::IndexType IndexType;
 	RS::LocationFinder<NR, GF> search;
-	int operator()(const ValueType *syndromes, IndexType *locations, ValueType *magnitudes, const IndexType *erasures = 0, int erasures_count = 0)
+	// only prepare() writes these, everything else just reads them and the tables of search
+	// ReedSolomonProductDecoder relies on that to share one decoder between its threads
+	ValueType shared_locator[NR+1];
+	IndexType shared_locations[NR], shared_factors[NR];
+	int shared_count = 0;
+	bool shared_distinct = true;
+	static void compute_locator(const IndexType *erasures, int erasures_count, ValueType *locator)
 	{
-		assert(0 <= erasures_count && erasures_count <= NR);
-		ValueType locator[NR+1];
 		locator[0] = ValueType(1);
 		for (int i = 1; i <= NR; ++i)
 			locator[i] = ValueType(0);
@@ -203,17 +388,98 @@ struct ReedSolomonErrorCorrection
 			for (int j = i; j >= 0; --j)
 				locator[j+1] += tmp * locator[j];
 		}
-		int locator_degree = RS::BerlekampMassey<NR, GF>::algorithm(syndromes, locator, erasures_count);
-		assert(locator_degree);
-		assert(locator_degree <= NR);
-		assert(locator[0] == ValueType(1));
-		while (!locator[locator_degree])
-			if (--locator_degree < 0)
-				return -1;
-		int count = search(locator, locator_degree, locations);
-		if (count < locator_degree)
-			return -1;
+	}
+	static bool distinct(const IndexType *erasures, int erasures_count)
+	{
+		for (int i = 1; i < erasures_count; ++i)
+			for (int j = 0; j < i; ++j)
+				if (erasures[i].i == erasures[j].i)
+					return false;
+		return true;
+	}
+	static bool consistent(const ValueType *syndromes, const ValueType *locator, int locator_degree)
+	{
+		// all the discrepancies Berlekamp-Massey would see are zero, so it would not touch the locator
+		for (int n = locator_degree; n < NR; ++n) {
+			ValueType d(syndromes[n]);
+			for (int i = 1; i <= locator_degree; ++i)
+				d += locator[i] * syndromes[n-i];
+			if (d)
+				return false;
+		}
+		return true;
+	}
+	void prepare(const IndexType *erasures, int erasures_count)
+	{
+		assert(0 <= erasures_count && erasures_count <= NR);
+		compute_locator(erasures, erasures_count, shared_locator);
+		shared_count = erasures_count;
+		shared_distinct = distinct(erasures, erasures_count);
+		for (int i = 0; i < erasures_count; ++i)
+			shared_locations[i] = erasures[i];
+		if (!shared_distinct)
+			return;
+		// $factor = \frac{root^{FCR-1}}{locator'(root)}$
+		for (int i = 0; i < erasures_count; ++i) {
+			IndexType root(erasures[i] * IndexType(1));
+			ValueType deriv(shared_locator[1]);
+			IndexType root2(root * root), tmp2(root2);
+			for (int j = 3; j <= erasures_count; j += 2) {
+				deriv += shared_locator[j] * tmp2;
+				tmp2 *= root2;
+			}
+			IndexType factor(rcp(index(deriv)));
+			if (FCR == 0)
+				factor /= root;
+			if (FCR > 1)
+				for (int j = 1; j < FCR; ++j)
+					factor *= root;
+			shared_factors[i] = factor;
+		}
+	}
+	int prepared(const ValueType *syndromes, IndexType *locations, ValueType *magnitudes, int length = GF::N)
+	{
+		if (!shared_distinct || !consistent(syndromes, shared_locator, shared_count))
+			return (*this)(syndromes, locations, magnitudes, shared_locations, shared_count, length);
 		ValueType evaluator[NR];
+		int evaluator_degree = RS::Forney<NR, FCR, GF>::compute_evaluator(syndromes, shared_locator, shared_count, evaluator);
+		for (int i = 0; i < shared_count; ++i) {
+			locations[i] = shared_locations[i];
+			IndexType root(shared_locations[i] * IndexType(1)), tmp(root);
+			ValueType eval(evaluator[0]);
+			for (int j = 1; j <= evaluator_degree; ++j) {
+				eval += evaluator[j] * tmp;
+				tmp *= root;
+			}
+			magnitudes[i] = eval ? value(index(eval) * shared_factors[i]) : ValueType(0);
+		}
+		return shared_count;
+	}
+	int operator()(const ValueType *syndromes, IndexType *locations, ValueType *magnitudes, const IndexType *erasures = 0, int erasures_count = 0, int length = GF::N)
+	{
+		assert(0 <= erasures_count && erasures_count <= NR);
+		assert(0 < length && length <= GF::N);
+		ValueType locator[NR+1];
+		compute_locator(erasures, erasures_count, locator);
+		int count;
+		if (erasures_count && distinct(erasures, erasures_count) && consistent(syndromes, locator, erasures_count)) {
+			// the erasures explain all the syndromes, so we already know the roots
+			for (int i = 0; i < erasures_count; ++i)
+				locations[i] = erasures[i];
+			count = erasures_count;
+		} else {
+			int locator_degree = KES<NR, GF>::algorithm(syndromes, locator, erasures_count);
+			assert(locator_degree);
+			assert(locator_degree <= NR);
+			assert(locator[0].v);
+			while (!locator[locator_degree])
+				if (--locator_degree < 0)
+					return -1;
+			count = search(locator, locator_degree, locations, length);
+			if (count < locator_degree)
+				return -1;
+		}
+		ValueType evaluator[NR] = { ValueType(0) };
 		int evaluator_degree = RS::Forney<NR, FCR, GF>::algorithm(syndromes, locator, locations, count, evaluator, magnitudes);
 		if (0) {
 			static bool once;
@@ -0,0 +1,118 @@
+/*
+Reed Solomon Product Code Decoder
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "parallel.hh"
+#include "reed_solomon_decoder.hh"
+
+namespace CODE {
+
+template <int ROW_ROOTS, int COL_ROOTS, int FCR, typename GF, template <int, typename> class KES = RS::BerlekampMassey>
+class ReedSolomonProductDecoder
+{
+public:
+	typedef typename GF::value_type value_type;
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	typedef ReedSolomonDecoder<ROW_ROOTS, FCR, GF, KES> RowDecoder;
+	typedef ReedSolomonDecoder<COL_ROOTS, FCR, GF, KES> ColDecoder;
+	static const int N = GF::N;
+	static const int ROW_K = RowDecoder::K, ROW_NP = RowDecoder::NP;
+	static const int COL_K = ColDecoder::K, COL_NP = ColDecoder::NP;
+private:
+	// the threads share the decoders, which is fine as long as nobody calls prepare() on them
+	RowDecoder row_decode;
+	ColDecoder col_decode;
+	int row_status[N], col_status[N];
+	template <typename DEC>
+	static void pass(DEC &decode, ValueType *block, int *status, int words, int length, int data_len, int word_stride, int symbol_stride, const IndexType *erasures, int erasures_count, ParallelPool *pool)
+	{
+		parallel_for(words, pool, [&](int w) {
+			ValueType tmp[N];
+			ValueType *word = block + w * word_stride;
+			if (symbol_stride != 1) {
+				for (int i = 0; i < length; ++i)
+					tmp[i] = word[i * symbol_stride];
+				word = tmp;
+			}
+			// the decoder shifts the erasures of shortened codes in place
+			IndexType copy[DEC::NR];
+			for (int i = 0; i < erasures_count; ++i)
+				copy[i] = erasures[i];
+			int ret = decode(word, word + data_len, copy, erasures_count, data_len);
+			if (ret > 0 && word == tmp)
+				for (int i = 0; i < length; ++i)
+					block[w * word_stride + i * symbol_stride] = tmp[i];
+			status[w] = ret;
+		});
+	}
+	static int failures(const int *status, int words, IndexType *erasures, int max_erasures, int *erasures_count)
+	{
+		// failed words of one direction are erasures for the other direction
+		int count = 0;
+		for (int w = 0; w < words; ++w) {
+			if (status[w] < 0) {
+				if (count < max_erasures)
+					erasures[count] = IndexType(w);
+				++count;
+			}
+		}
+		*erasures_count = count <= max_erasures ? count : 0;
+		return count;
+	}
+	static int corrections(const int *status, int words)
+	{
+		int count = 0;
+		for (int w = 0; w < words; ++w)
+			if (status[w] > 0)
+				count += status[w];
+		return count;
+	}
+public:
+	// $block$ holds $col\_data\_len + COL\_NP$ rows of $row\_data\_len + ROW\_NP$ symbols each, the passes run on $pool$ if given
+	int operator()(ValueType *block, int row_data_len = ROW_K, int col_data_len = COL_K, int iterations = 4, ParallelPool *pool = 0)
+	{
+		assert(0 < row_data_len && row_data_len <= ROW_K);
+		assert(0 < col_data_len && col_data_len <= COL_K);
+		int rows = col_data_len + COL_NP, cols = row_data_len + ROW_NP;
+		IndexType row_erasures[ROW_NP], col_erasures[COL_NP];
+		int row_erasures_count = 0, col_erasures_count = 0;
+		int corrections_count = 0;
+		bool rows_valid = false, cols_valid = false;
+		for (int iter = 0; iter < iterations; ++iter) {
+			pass(row_decode, block, row_status, rows, cols, row_data_len, cols, 1, row_erasures, row_erasures_count, pool);
+			int row_corrections = corrections(row_status, rows);
+			corrections_count += row_corrections;
+			rows_valid = !failures(row_status, rows, col_erasures, COL_NP, &col_erasures_count);
+			if (rows_valid && cols_valid && !row_corrections)
+				return corrections_count;
+			pass(col_decode, block, col_status, cols, rows, col_data_len, 1, cols, col_erasures, col_erasures_count, pool);
+			int col_corrections = corrections(col_status, cols);
+			corrections_count += col_corrections;
+			cols_valid = !failures(col_status, cols, row_erasures, ROW_NP, &row_erasures_count);
+			if (rows_valid && cols_valid && !col_corrections)
+				return corrections_count;
+		}
+		if (!cols_valid)
+			return -1;
+		// the last column pass might have changed rows that were fine before
+		for (int r = 0; r < rows; ++r) {
+			ValueType syndromes[ROW_NP];
+			ValueType *row = block + r * cols;
+			if (row_decode.compute_syndromes(row, row + row_data_len, syndromes, row_data_len))
+				return -1;
+		}
+		return corrections_count;
+	}
+	int operator()(value_type *block, int row_data_len = ROW_K, int col_data_len = COL_K, int iterations = 4, ParallelPool *pool = 0)
+	{
+		return (*this)(reinterpret_cast<ValueType *>(block), row_data_len, col_data_len, iterations, pool);
+	}
+};
+
+}
+
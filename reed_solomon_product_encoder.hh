@@ -0,0 +1,57 @@
+/*
+Reed Solomon Product Code Encoder
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include "parallel.hh"
+#include "reed_solomon_encoder.hh"
+
+namespace CODE {
+
+template <int ROW_ROOTS, int COL_ROOTS, int FCR, typename GF>
+class ReedSolomonProductEncoder
+{
+public:
+	typedef typename GF::value_type value_type;
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	typedef ReedSolomonEncoder<ROW_ROOTS, FCR, GF> RowEncoder;
+	typedef ReedSolomonEncoder<COL_ROOTS, FCR, GF> ColEncoder;
+	static const int N = GF::N;
+	static const int ROW_K = RowEncoder::K, ROW_NP = RowEncoder::NP;
+	static const int COL_K = ColEncoder::K, COL_NP = ColEncoder::NP;
+private:
+	RowEncoder row_encode;
+	ColEncoder col_encode;
+public:
+	// $block$ holds $col\_data\_len + COL\_NP$ rows of $row\_data\_len + ROW\_NP$ symbols each, the passes run on $pool$ if given
+	void operator()(ValueType *block, int row_data_len = ROW_K, int col_data_len = COL_K, ParallelPool *pool = 0)
+	{
+		assert(0 < row_data_len && row_data_len <= ROW_K);
+		assert(0 < col_data_len && col_data_len <= COL_K);
+		int cols = row_data_len + ROW_NP;
+		parallel_for(col_data_len, pool, [&](int r) {
+			ValueType *row = block + r * cols;
+			row_encode(row, row + row_data_len, row_data_len);
+		});
+		// the parity rows of a linear code are row codewords as well, so we also encode the parity columns
+		parallel_for(cols, pool, [&](int c) {
+			ValueType tmp[N];
+			for (int r = 0; r < col_data_len; ++r)
+				tmp[r] = block[r * cols + c];
+			col_encode(tmp, tmp + col_data_len, col_data_len);
+			for (int r = col_data_len; r < col_data_len + COL_NP; ++r)
+				block[r * cols + c] = tmp[r];
+		});
+	}
+	void operator()(value_type *block, int row_data_len = ROW_K, int col_data_len = COL_K, ParallelPool *pool = 0)
+	{
+		(*this)(reinterpret_cast<ValueType *>(block), row_data_len, col_data_len, pool);
+	}
+};
+
+}
+
@@ -0,0 +1,73 @@
+/*
+Bit sliced cyclic redundancy check over all SIMD lanes at once
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <utility>
+#include "simd.hh"
+
+namespace CODE {
+
+template <typename TYPE, typename CRC_TYPE>
+class SIMDCRC
+{
+public:
+	// lanes are all ones or all zeros
+	typedef decltype(vcltz(std::declval<TYPE>())) MASK;
+	static const int W = 8 * sizeof(CRC_TYPE);
+private:
+	// register bit $j$ of every lane is $reg_{(head+j) \bmod W}$, so shifting is just moving the head
+	MASK reg[W];
+	int taps[W];
+	int count;
+	int head;
+public:
+	SIMDCRC(CRC_TYPE poly) : count(0), head(0)
+	{
+		for (int j = 0; j < W; ++j)
+			if ((poly >> j) & 1)
+				taps[count++] = j;
+		reset();
+	}
+	void reset(CRC_TYPE v = 0)
+	{
+		head = 0;
+		for (int j = 0; j < W; ++j)
+			reg[j] = (v >> j) & 1 ? vdup<MASK>(-1) : vzero<MASK>();
+	}
+	// pass mask of all lanes, same as CRC<CRC_TYPE>::operator()() == 0 for each lane
+	MASK operator()()
+	{
+		MASK acc = reg[0];
+		for (int j = 1; j < W; ++j)
+			acc = vorr(acc, reg[j]);
+		return veor(acc, vdup<MASK>(-1));
+	}
+	// a negative value is a one bit, just like the hard decisions of the polar decoders
+	void operator()(TYPE bits)
+	{
+		MASK fb = veor(reg[head], vcltz(bits));
+		reg[head] = vzero<MASK>();
+		if (++head == W)
+			head = 0;
+		for (int i = 0; i < count; ++i) {
+			int j = head + taps[i];
+			if (j >= W)
+				j -= W;
+			reg[j] = veor(reg[j], fb);
+		}
+	}
+	MASK operator()(const TYPE *message, int length, CRC_TYPE v = 0)
+	{
+		reset(v);
+		for (int i = 0; i < length; ++i)
+			(*this)(message[i]);
+		return (*this)();
+	}
+};
+
+}
+
@@ -0,0 +1,176 @@
+/*
+Monte Carlo simulation of error rates over a range of SNRs
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <vector>
+#include <cstring>
+#include <ostream>
+#include <thread>
+#include <algorithm>
+
+namespace CODE {
+
+// every frame gets its own generator, seeded from the seed, the SNR and the frame number
+typedef std::mt19937 SimulationRNG;
+
+struct SimulationPoint
+{
+	float snr;
+	uint64_t frames, frame_errors, bits, bit_errors;
+	double seconds;
+	double fer() const
+	{
+		return frames ? double(frame_errors) / frames : 0;
+	}
+	double ber() const
+	{
+		return bits ? double(bit_errors) / bits : 0;
+	}
+};
+
+// BPSK over AWGN at $E_s/N_0 = snr$ dB, quantized to LLRs the same way the regression tests always did
+template <typename RNG>
+void simulation_awgn(RNG &rng, float snr, const int8_t *bpsk, int8_t *llr, int length, float factor = 2)
+{
+	float sigma_noise = std::sqrt(1 / (2 * std::pow(10, snr / 10)));
+	std::normal_distribution<float> awgn(0, sigma_noise);
+	float fact = 2 * factor / (sigma_noise * sigma_noise);
+	for (int i = 0; i < length; ++i)
+		llr[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (bpsk[i] + awgn(rng))), -127), 127);
+}
+
+/*
+CHAIN runs encoder, modulator, channel and decoder for one frame:
+int CHAIN::operator()(SimulationRNG &rng, float snr) returns the number of bit errors
+int CHAIN::bits() returns the number of bits in a frame
+Every worker thread gets its own CHAIN, so decoders can keep their state.
+*/
+template <typename CHAIN>
+class Simulation
+{
+	std::vector<CHAIN *> chains;
+	uint32_t seed;
+	uint64_t max_frames, min_frame_errors;
+	int threads, window;
+
+	static void idle(int &spins)
+	{
+		// don't burn a core while waiting for the others
+		if (++spins < 64)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+public:
+	// stops after $min\_frame\_errors$ frame errors or $max\_frames$ frames, whatever comes first
+	Simulation(int threads, uint32_t seed, uint64_t max_frames, uint64_t min_frame_errors = 100, int window = 0) :
+		seed(seed), max_frames(max_frames), min_frame_errors(min_frame_errors), threads(threads), window(window)
+	{
+		assert(threads > 0 && max_frames > 0);
+		if (this->window <= 0)
+			this->window = 16 * threads;
+		for (int t = 0; t < threads; ++t)
+			chains.push_back(new CHAIN());
+	}
+	~Simulation()
+	{
+		for (auto chain: chains)
+			delete chain;
+	}
+	// frames are run in any order but counted in order, so the result doesn't depend on the number of threads
+	SimulationPoint operator()(float snr)
+	{
+		SimulationPoint point = { snr, 0, 0, 0, 0, 0 };
+		uint32_t snr_bits;
+		std::memcpy(&snr_bits, &snr, sizeof(snr_bits));
+		// frame $f$ is kept in slot $f \bmod window$ until it is counted, $ready$ tells which frame is in there
+		std::vector<int> errors(window);
+		std::vector<std::atomic<uint64_t>> ready(window);
+		for (auto &r: ready)
+			r = 0;
+		std::atomic<uint64_t> next(0), counted(0);
+		std::atomic<bool> stop(false);
+		int bits = chains[0]->bits();
+		auto start = std::chrono::steady_clock::now();
+		// the workers live until the stopping rule hits, whoever is idle takes the next frame number
+		auto work = [&](CHAIN *chain) {
+			int spins = 0;
+			for (uint64_t frame = next++; frame < max_frames; frame = next++) {
+				while (frame >= counted.load(std::memory_order_acquire) + window && !stop.load(std::memory_order_relaxed))
+					idle(spins);
+				if (stop.load(std::memory_order_relaxed))
+					return;
+				spins = 0;
+				std::seed_seq seq { seed, snr_bits, uint32_t(frame), uint32_t(frame >> 32) };
+				SimulationRNG rng(seq);
+				errors[frame % window] = (*chain)(rng, snr);
+				ready[frame % window].store(frame + 1, std::memory_order_release);
+			}
+		};
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+			workers.emplace_back(work, chains[t]);
+		for (int spins = 0; point.frames < max_frames && point.frame_errors < min_frame_errors;) {
+			uint64_t frame = point.frames;
+			if (ready[frame % window].load(std::memory_order_acquire) != frame + 1) {
+				idle(spins);
+				continue;
+			}
+			spins = 0;
+			int errs = errors[frame % window];
+			++point.frames;
+			point.bits += bits;
+			point.bit_errors += errs;
+			point.frame_errors += !!errs;
+			counted.store(point.frames, std::memory_order_release);
+		}
+		stop = true;
+		for (auto &thread: workers)
+			thread.join();
+		auto end = std::chrono::steady_clock::now();
+		point.seconds = std::chrono::duration<double>(end - start).count();
+		return point;
+	}
+	// from $first$ to $last$ dB in $step$ dB steps, optionally stopping once no frame errors are left
+	std::vector<SimulationPoint> sweep(float first, float last, float step, bool until_error_free = true)
+	{
+		std::vector<SimulationPoint> points;
+		for (int i = 0; first + i * step <= last + step / 2; ++i) {
+			points.push_back((*this)(first + i * step));
+			if (until_error_free && !points.back().frame_errors)
+				break;
+		}
+		return points;
+	}
+};
+
+static inline void simulation_csv(std::ostream &os, const std::vector<SimulationPoint> &points)
+{
+	os << "snr,frames,frame_errors,bits,bit_errors,fer,ber,seconds" << std::endl;
+	for (auto &p: points)
+		os << p.snr << "," << p.frames << "," << p.frame_errors << "," << p.bits << "," << p.bit_errors << "," << p.fer() << "," << p.ber() << "," << p.seconds << std::endl;
+}
+
+static inline void simulation_json(std::ostream &os, const std::vector<SimulationPoint> &points)
+{
+	os << "[";
+	for (size_t i = 0; i < points.size(); ++i) {
+		auto &p = points[i];
+		os << (i ? ",\n" : "\n");
+		os << "  {\"snr\": " << p.snr << ", \"frames\": " << p.frames << ", \"frame_errors\": " << p.frame_errors;
+		os << ", \"bits\": " << p.bits << ", \"bit_errors\": " << p.bit_errors;
+		os << ", \"fer\": " << p.fer() << ", \"ber\": " << p.ber() << ", \"seconds\": " << p.seconds << "}";
+	}
+	os << "\n]" << std::endl;
+}
+
+}
+
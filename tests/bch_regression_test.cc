@@ -142,6 +142,63 @@ void bch_reference_test(ENC *encode, DEC *decode, int trials)
 	}
 }
 
+template <typename ENC, typename DEC>
+void bch_batch_test(ENC *encode, DEC *decode, int trials)
+{
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::uniform_int_distribution<typename DEC::value_type> distribution;
+	auto rnd_cnt = std::bind(distribution(0, DEC::NR / 2), generator);
+	auto rnd_len = std::bind(distribution(1, ENC::K), generator);
+	auto rnd_val = std::bind(distribution(0, 255), generator);
+	const int BLOCKS = 8;
+	const int P = (ENC::NP + 7) / 8;
+	uint8_t *data = new uint8_t[BLOCKS * ((ENC::K + 7) / 8)];
+	uint8_t *orig_data = new uint8_t[BLOCKS * ((ENC::K + 7) / 8)];
+	uint8_t parity[BLOCKS * P], orig_parity[BLOCKS * P];
+	while (--trials) {
+		int data_len = rnd_len();
+		auto rnd_pos = std::bind(distribution(0, data_len + ENC::NP - 1), generator);
+		int D = (data_len + 7) / 8;
+		for (int i = 0; i < BLOCKS * D; ++i)
+			data[i] = orig_data[i] = rnd_val();
+		for (int b = 0; b < BLOCKS; ++b)
+			(*encode)(data + b * D, parity + b * P, data_len);
+		for (int i = 0; i < BLOCKS * P; ++i)
+			orig_parity[i] = parity[i];
+		// most blocks stay clean, the others get up to T errors
+		for (int b = 0; b < BLOCKS; b += 3) {
+			int error_count = rnd_cnt();
+			typename DEC::value_type errors[DEC::NR];
+			for (int i = 0; i < error_count; ++i) {
+				int pos = rnd_pos();
+				for (int j = 0; j < i; ++j) {
+					if (errors[j] == pos) {
+						pos = rnd_pos();
+						j = -1;
+					}
+				}
+				errors[i] = pos;
+				if (pos < data_len)
+					CODE::xor_be_bit(data + b * D, pos, 1);
+				else
+					CODE::xor_be_bit(parity + b * P, pos-data_len, 1);
+			}
+		}
+		int results[BLOCKS];
+		int failures = decode->batch(data, parity, BLOCKS, results, data_len, trials % 3 + 1);
+		assert(!failures);
+		for (int b = 0; b < BLOCKS; ++b)
+			assert(results[b] >= 0 && (b % 3 == 0 || !results[b]));
+		for (int i = 0; i < BLOCKS * D; ++i)
+			assert(data[i] == orig_data[i]);
+		for (int i = 0; i < BLOCKS * P; ++i)
+			assert(parity[i] == orig_parity[i]);
+	}
+	delete[] data;
+	delete[] orig_data;
+}
+
 int main()
 {
 	if (1) {
@@ -174,6 +231,7 @@ int main()
 			0b100011011, 0b100111111, 0b110001101, 0b100101101});
 		CODE::BoseChaudhuriHocquenghemDecoder<36, 1, 131, GF> decoder;
 		bch_test(&encoder, &decoder, 10000);
+		bch_batch_test(&encoder, &decoder, 1000);
 	}
 	if (1) {
 		// DVB-S2 FULL BCH(16383, 16215) T=12
@@ -210,6 +268,7 @@ int main()
 			0b10111010110100111, 0b10011101000101101, 0b10001101011100011});
 		CODE::BoseChaudhuriHocquenghemDecoder<24, 1, 65343, GF> decoder;
 		bch_test(&encoder, &decoder, 100);
+		bch_batch_test(&encoder, &decoder, 20);
 	}
 	if (1) {
 		// NASA INTRO BCH(15, 5) T=3
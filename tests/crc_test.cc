@@ -9,6 +9,7 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 #include <iostream>
 #include <bitset>
 #include "crc.hh"
+#include "simd_crc.hh"
 
 int main()
 {
@@ -51,6 +52,188 @@ int main()
 		for (uint8_t c: std::string("Hello World!")) crc(c);
 		assert(!crc(uint8_t(0x9E)));
 	}
+	if (1) {
+		uint8_t buf[1000];
+		for (int i = 0; i < 1000; ++i)
+			buf[i] = i * 251 + (i >> 3);
+		for (int len = 0; len < 1000; len += 37) {
+			CODE::CRC<uint64_t, 1> ref64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+			CODE::CRC<uint64_t, 8> crc64_8(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+			CODE::CRC<uint64_t, 16> crc64_16(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+			for (int i = 0; i < len; ++i) ref64(buf[i]);
+			assert(crc64_8.update(buf, len) == ref64());
+			assert(crc64_16.update(buf, len) == ref64());
+			CODE::CRC<uint32_t, 1> ref32(0xEDB88320, 0xFFFFFFFF);
+			CODE::CRC<uint32_t, 8> crc32_8(0xEDB88320, 0xFFFFFFFF);
+			CODE::CRC<uint32_t, 16> crc32_16(0xEDB88320, 0xFFFFFFFF);
+			for (int i = 0; i < len; ++i) ref32(buf[i]);
+			assert(crc32_8.update(buf, len) == ref32());
+			assert(crc32_16.update(buf, len) == ref32());
+			CODE::CRC<uint32_t, 1> ref32c(0x82F63B78, 0xFFFFFFFF);
+			CODE::CRC<uint32_t> crc32c(0x82F63B78, 0xFFFFFFFF);
+			for (int i = 0; i < len; ++i) ref32c(buf[i]);
+			assert(crc32c.update(buf, len) == ref32c());
+			CODE::CRC<uint16_t, 1> ref16(0xA8F4);
+			CODE::CRC<uint16_t, 16> crc16(0xA8F4);
+			for (int i = 0; i < len; ++i) ref16(buf[i]);
+			assert(crc16.update(buf, len) == ref16());
+			CODE::CRC<uint8_t, 1> ref8(0x8C);
+			CODE::CRC<uint8_t, 16> crc8(0x8C);
+			for (int i = 0; i < len; ++i) ref8(buf[i]);
+			assert(crc8.update(buf, len) == ref8());
+		}
+		CODE::CRC<uint32_t, 16> crc(0xEDB88320, 0xFFFFFFFF);
+		crc.update(reinterpret_cast<const uint8_t *>("Hello World!"), 12);
+		assert(~crc() == 0x1C291CA3);
+		CODE::CRC<uint64_t, 16> crc64(0xC96C5795D7870F42);
+		crc64(uint32_t(0x12345678));
+		crc64(uint16_t(0x9ABC));
+		crc64(uint64_t(0x0123456789ABCDEF));
+		CODE::CRC<uint64_t, 1> ref64(0xC96C5795D7870F42);
+		ref64(uint32_t(0x12345678));
+		ref64(uint16_t(0x9ABC));
+		ref64(uint64_t(0x0123456789ABCDEF));
+		assert(crc64() == ref64());
+	}
+	if (1) {
+		// around the lengths where carry-less folding kicks in, with unaligned starts and tails
+		uint8_t buf[300];
+		for (int i = 0; i < 300; ++i)
+			buf[i] = i * 157 + (i >> 2);
+		for (int len: { 127, 128, 129, 191, 192, 193, 255, 256, 257, 271 }) {
+			for (int off = 0; off < 4; ++off) {
+				const uint8_t *data = buf + off;
+				CODE::CRC<uint64_t, 1> ref64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+				CODE::CRC<uint64_t, 1> crc64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+				CODE::CRC<uint64_t, 16> crc64_16(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+				for (int i = 0; i < len; ++i) ref64(data[i]);
+				assert(crc64.update(data, len) == ref64());
+				assert(crc64_16.update(data, len) == ref64());
+				CODE::CRC<uint32_t, 1> ref32(0xEDB88320, 0xFFFFFFFF);
+				CODE::CRC<uint32_t, 1> crc32(0xEDB88320, 0xFFFFFFFF);
+				CODE::CRC<uint32_t, 8> crc32_8(0xEDB88320, 0xFFFFFFFF);
+				for (int i = 0; i < len; ++i) ref32(data[i]);
+				assert(crc32.update(data, len) == ref32());
+				assert(crc32_8.update(data, len) == ref32());
+				CODE::CRC<uint16_t, 1> ref16(0xA8F4, 0xFFFF);
+				CODE::CRC<uint16_t, 1> crc16(0xA8F4, 0xFFFF);
+				for (int i = 0; i < len; ++i) ref16(data[i]);
+				assert(crc16.update(data, len) == ref16());
+				CODE::CRC<uint8_t, 1> ref8(0x8C, 0xFF);
+				CODE::CRC<uint8_t, 1> crc8(0x8C, 0xFF);
+				for (int i = 0; i < len; ++i) ref8(data[i]);
+				assert(crc8.update(data, len) == ref8());
+			}
+		}
+	}
+	if (1) {
+		// tables are shared, instances only hold the register
+		static_assert(sizeof(CODE::StaticCRC<uint64_t, 0xC96C5795D7870F42>) == sizeof(uint64_t), "instance holds more than the register");
+		uint8_t buf[1000];
+		for (int i = 0; i < 1000; ++i)
+			buf[i] = i * 251 + (i >> 3);
+		for (int len = 0; len < 1000; len += 37) {
+			CODE::CRC<uint64_t, 1> ref64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+			CODE::StaticCRC<uint64_t, 0xC96C5795D7870F42> crc64(0xFFFFFFFFFFFFFFFF);
+			for (int i = 0; i < len; ++i) ref64(buf[i]);
+			assert(crc64.update(buf, len) == ref64());
+			CODE::CRC<uint32_t, 1> ref32(0xEDB88320, 0xFFFFFFFF);
+			CODE::StaticCRC<uint32_t, 0xEDB88320> crc32(0xFFFFFFFF);
+			for (int i = 0; i < len; ++i) ref32(buf[i]);
+			assert(crc32.update(buf, len) == ref32());
+			CODE::CRC<uint16_t, 1> ref16(0xA8F4);
+			CODE::StaticCRC<uint16_t, 0xA8F4> crc16;
+			for (int i = 0; i < len; ++i) ref16(buf[i]);
+			assert(crc16.update(buf, len) == ref16());
+			CODE::CRC<uint8_t, 1> ref8(0x8C);
+			CODE::StaticCRC<uint8_t, 0x8C> crc8;
+			for (int i = 0; i < len; ++i) ref8(buf[i]);
+			assert(crc8.update(buf, len) == ref8());
+		}
+		CODE::StaticCRC<uint32_t, 0xEDB88320> crc(0xFFFFFFFF);
+		for (uint8_t c: std::string("Hello World!")) crc(c);
+		assert(~crc() == 0x1C291CA3);
+		CODE::StaticCRC<uint32_t, 0xD419CC15> crc32;
+		CODE::CRC<uint32_t> ref32(0xD419CC15);
+		for (int i = 0; i < 100; ++i)
+			assert(crc32(bool(buf[i] & 1)) == ref32(bool(buf[i] & 1)));
+		crc32(uint16_t(0x9ABC));
+		crc32(uint64_t(0x0123456789ABCDEF));
+		ref32(uint16_t(0x9ABC));
+		ref32(uint64_t(0x0123456789ABCDEF));
+		assert(crc32() == ref32());
+		assert(!crc32(crc32()));
+	}
+	if (1) {
+		const int LEN = 1 << 20;
+		uint8_t *buf = new uint8_t[LEN];
+		for (int i = 0; i < LEN; ++i)
+			buf[i] = i * 251 + (i >> 11);
+		CODE::CRC<uint32_t> ref(0xEDB88320, 0xFFFFFFFF);
+		ref.update(buf, LEN);
+		CODE::CRC<uint32_t> crc(0xEDB88320, 0xFFFFFFFF);
+		assert(crc.update(buf, LEN, 4) == ref());
+		for (int split = 0; split <= 1000; split += 111) {
+			CODE::CRC<uint32_t> a(0xEDB88320, 0xFFFFFFFF), b(0xEDB88320);
+			a.update(buf, split);
+			b.update(buf + split, 1000 - split);
+			CODE::CRC<uint32_t> c(0xEDB88320, 0xFFFFFFFF);
+			c.update(buf, 1000);
+			assert(a.combine(a(), b(), 1000 - split) == c());
+		}
+		// check value of CRC-32C
+		CODE::CRC<uint32_t> crc32c(0x82F63B78, 0xFFFFFFFF);
+		crc32c.update(reinterpret_cast<const uint8_t *>("123456789"), 9);
+		assert(~crc32c() == 0xE3069283);
+		CODE::CRC<uint32_t, 1> ref32c(0x82F63B78, 0xFFFFFFFF);
+		for (int i = 0; i < LEN; ++i) ref32c(buf[i]);
+		crc32c.reset(0xFFFFFFFF);
+		assert(crc32c.update(buf, LEN) == ref32c());
+		crc32c.reset(0xFFFFFFFF);
+		assert(crc32c.update(buf, LEN, 4) == ref32c());
+		CODE::CRC<uint64_t, 16> ref64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+		ref64.update(buf, LEN);
+		CODE::CRC<uint64_t, 16> crc64(0xC96C5795D7870F42, 0xFFFFFFFFFFFFFFFF);
+		assert(crc64.update(buf, LEN, 3) == ref64());
+		CODE::CRC<uint16_t> ref16(0xA8F4);
+		ref16.update(buf, LEN);
+		CODE::CRC<uint16_t> crc16(0xA8F4);
+		assert(crc16.update(buf, LEN, 5) == ref16());
+		delete[] buf;
+	}
+	if (1) {
+		// bit sliced over all lanes must agree with checking each lane on its own
+		const int K = 1000, L = 32;
+		typedef SIMD<int8_t, L> simd_type;
+		simd_type *message = new simd_type[K];
+		uint32_t lfsr = 1;
+		for (int i = 0; i < K; ++i) {
+			for (int k = 0; k < L; ++k) {
+				lfsr = lfsr * 1103515245 + 12345;
+				message[i].v[k] = (lfsr >> 16) & 1 ? -1 : 1;
+			}
+		}
+		// make every odd lane a valid codeword by appending its crc
+		CODE::CRC<uint32_t> crc(0xD419CC15);
+		for (int k = 1; k < L; k += 2) {
+			crc.reset();
+			for (int i = 0; i < K - 32; ++i)
+				crc(message[i].v[k] < 0);
+			uint32_t parity = crc();
+			for (int i = 0; i < 32; ++i)
+				message[K - 32 + i].v[k] = (parity >> i) & 1 ? -1 : 1;
+		}
+		CODE::SIMDCRC<simd_type, uint32_t> simd_crc(0xD419CC15);
+		auto pass = simd_crc(message, K);
+		for (int k = 0; k < L; ++k) {
+			crc.reset();
+			for (int i = 0; i < K; ++i)
+				crc(message[i].v[k] < 0);
+			assert(!!pass.v[k] == !crc());
+			assert(!!pass.v[k] == (k & 1));
+		}
+		delete[] message;
+	}
 	std::cerr << "Cyclic redundancy check test passed!" << std::endl;
 	return 0;
 }
@@ -0,0 +1,1080 @@
+/*
+Regression Test for the 5G NR like LDPC Encoder and Decoder
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#include <cassert>
+#include <random>
+#include <iostream>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include "ldpc_nr_encoder.hh"
+#include "ldpc_nr_decoder.hh"
+
+// a small base graph with the same structure as BG1 and BG2: a double diagonal core of four rows and the single diagonal extension below
+struct TOY_BASE_GRAPH
+{
+	static const int ROWS = 8;
+	static const int COLS = 16;
+	static const int LINKS = 57;
+	static const int DEG_MAX = 9;
+	static constexpr int DEG[] = {
+		8, 9, 8, 8, 6, 6, 6, 6
+	};
+	static constexpr int POS[] = {
+		0,	1,	2,	3,	5,	6,	8,	9,
+		0,	2,	3,	4,	6,	7,	8,	9,	10,
+		0,	1,	3,	4,	5,	7,	10,	11,
+		1,	2,	4,	5,	6,	7,	8,	11,
+		0,	1,	4,	6,	8,	12,
+		2,	3,	5,	7,	9,	13,
+		0,	3,	5,	6,	8,	14,
+		1,	2,	4,	7,	9,	15,
+	};
+	static constexpr int SHI[8][LINKS] = {
+		{
+			14,	238,	127,	332,	26,	80,	318,	0,
+			57,	190,	240,	126,	194,	278,	5,	0,	0,
+			52,	293,	127,	6,	374,	110,	0,	0,
+			208,	143,	93,	199,	81,	36,	318,	0,
+			71,	316,	316,	227,	64,	0,
+			67,	0,	2,	107,	110,	0,
+			84,	85,	148,	160,	101,	0,
+			276,	347,	320,	104,	93,	0,
+		},
+		{
+			353,	100,	196,	152,	11,	184,	130,	0,
+			212,	84,	74,	135,	33,	169,	5,	0,	0,
+			154,	308,	300,	1,	305,	347,	0,	0,
+			362,	173,	33,	158,	181,	156,	130,	0,
+			246,	356,	161,	94,	246,	0,
+			241,	360,	90,	29,	131,	0,
+			11,	383,	183,	206,	9,	0,
+			281,	214,	187,	192,	296,	0,
+		},
+		{
+			4,	231,	23,	362,	92,	319,	379,	0,
+			100,	60,	125,	236,	176,	262,	5,	0,	0,
+			181,	268,	128,	236,	55,	301,	0,	0,
+			383,	188,	151,	18,	221,	46,	379,	0,
+			106,	174,	262,	312,	185,	0,
+			75,	174,	141,	359,	279,	0,
+			47,	159,	351,	162,	156,	0,
+			90,	40,	320,	76,	369,	0,
+		},
+		{
+			352,	158,	247,	82,	368,	24,	183,	0,
+			41,	307,	273,	207,	16,	121,	5,	0,	0,
+			379,	304,	176,	128,	233,	333,	0,	0,
+			215,	74,	28,	326,	16,	252,	183,	0,
+			171,	106,	66,	374,	288,	0,
+			67,	322,	211,	54,	86,	0,
+			222,	190,	76,	30,	215,	0,
+			150,	72,	232,	317,	86,	0,
+		},
+		{
+			267,	232,	249,	352,	373,	162,	353,	0,
+			245,	140,	149,	240,	206,	75,	5,	0,	0,
+			57,	193,	272,	91,	321,	255,	0,	0,
+			173,	92,	45,	251,	139,	263,	353,	0,
+			280,	257,	184,	32,	182,	0,
+			355,	300,	339,	17,	156,	0,
+			186,	286,	360,	342,	143,	0,
+			248,	135,	353,	366,	150,	0,
+		},
+		{
+			174,	332,	91,	297,	5,	242,	378,	0,
+			280,	128,	166,	343,	140,	237,	5,	0,	0,
+			147,	256,	331,	344,	182,	178,	0,	0,
+			140,	329,	176,	377,	209,	179,	378,	0,
+			88,	352,	230,	186,	171,	0,
+			265,	72,	271,	85,	101,	0,
+			185,	244,	144,	354,	40,	0,
+			368,	343,	373,	213,	87,	0,
+		},
+		{
+			315,	297,	264,	340,	215,	154,	333,	0,
+			319,	283,	326,	138,	368,	14,	5,	0,	0,
+			100,	81,	300,	225,	319,	332,	0,	0,
+			92,	112,	351,	92,	323,	367,	333,	0,
+			21,	241,	115,	84,	27,	0,
+			68,	56,	162,	92,	247,	0,
+			99,	280,	18,	212,	238,	0,
+			179,	194,	339,	313,	36,	0,
+		},
+		{
+			302,	104,	121,	367,	191,	0,	271,	0,
+			179,	207,	142,	209,	58,	352,	5,	0,	0,
+			280,	191,	18,	281,	314,	154,	0,	0,
+			48,	151,	279,	262,	173,	297,	271,	0,
+			150,	180,	66,	214,	209,	0,
+			288,	328,	275,	189,	239,	0,
+			72,	80,	305,	195,	288,	0,
+			244,	101,	68,	311,	46,	0,
+		},
+	};
+};
+
+// sized like BG1 with its double diagonal core, 46 rows, 68 columns and up to 19 links per row, but these are not the shift values of 3GPP TS 38.212
+struct BG1_LIKE_BASE_GRAPH
+{
+	static const int ROWS = 46;
+	static const int COLS = 68;
+	static const int LINKS = 316;
+	static const int DEG_MAX = 19;
+	static constexpr int DEG[] = {
+		19, 19, 19, 19, 3, 8, 9, 7, 10, 9, 7, 8, 7, 6, 7, 7,
+		6, 6, 6, 6, 6, 6, 5, 5, 6, 5, 5, 4, 5, 5, 5, 5,
+		5, 5, 5, 5, 5, 4, 5, 5, 4, 5, 4, 5, 5, 4
+	};
+	static constexpr int POS[] = {
+		0,	1,	2,	3,	5,	6,	9,	10,	11,	12,	13,	15,	16,	18,	19,	20,	21,	22,	23,
+		0,	2,	3,	4,	5,	7,	8,	9,	11,	12,	14,	15,	16,	17,	19,	21,	22,	23,	24,
+		0,	1,	2,	4,	5,	6,	7,	8,	9,	10,	13,	14,	15,	17,	18,	19,	20,	24,	25,
+		0,	1,	3,	4,	6,	7,	8,	10,	11,	12,	13,	14,	16,	17,	18,	20,	21,	22,	25,
+		0,	1,	26,
+		0,	1,	3,	12,	16,	21,	22,	27,
+		0,	6,	10,	11,	13,	17,	18,	20,	28,
+		0,	1,	4,	7,	8,	14,	29,
+		0,	1,	3,	12,	16,	19,	21,	22,	24,	30,
+		0,	1,	10,	11,	13,	17,	18,	20,	31,
+		1,	2,	4,	7,	8,	14,	32,
+		0,	1,	12,	16,	21,	22,	23,	33,
+		0,	1,	10,	11,	13,	18,	34,
+		0,	3,	7,	20,	23,	35,
+		0,	12,	15,	16,	17,	21,	36,
+		0,	1,	10,	13,	18,	25,	37,
+		1,	3,	11,	20,	22,	38,
+		0,	14,	16,	17,	21,	39,
+		1,	12,	13,	18,	19,	40,
+		0,	1,	7,	8,	10,	41,
+		0,	3,	9,	11,	22,	42,
+		1,	5,	16,	20,	21,	43,
+		0,	12,	13,	17,	44,
+		1,	2,	10,	18,	45,
+		0,	3,	4,	11,	22,	46,
+		1,	6,	7,	14,	47,
+		0,	2,	4,	15,	48,
+		1,	6,	8,	49,
+		0,	4,	19,	21,	50,
+		1,	14,	18,	25,	51,
+		0,	10,	13,	24,	52,
+		1,	7,	22,	25,	53,
+		0,	12,	14,	24,	54,
+		1,	2,	11,	21,	55,
+		0,	7,	15,	17,	56,
+		1,	6,	12,	22,	57,
+		0,	14,	15,	18,	58,
+		1,	13,	23,	59,
+		0,	9,	10,	12,	60,
+		1,	3,	7,	19,	61,
+		0,	8,	17,	62,
+		1,	3,	9,	18,	63,
+		0,	4,	24,	64,
+		1,	16,	18,	25,	65,
+		0,	7,	9,	22,	66,
+		1,	6,	10,	67,
+	};
+	static constexpr int SHI[8][LINKS] = {
+		{
+			250,	69,	226,	159,	100,	10,	59,	229,	110,	191,	9,	195,	23,	190,	35,	239,	31,	1,	0,
+			2,	239,	117,	124,	71,	222,	104,	173,	220,	102,	109,	132,	142,	155,	255,	28,	0,	0,	0,
+			106,	111,	185,	63,	117,	93,	229,	177,	95,	39,	142,	225,	225,	245,	205,	251,	117,	0,	0,
+			121,	89,	84,	20,	150,	131,	243,	136,	86,	246,	219,	211,	240,	76,	244,	144,	12,	1,	0,
+			1,	0,	0,
+			254,	190,	71,	99,	69,	172,	0,	0,
+			75,	35,	91,	127,	245,	25,	143,	47,	0,
+			100,	52,	70,	97,	187,	206,	0,
+			46,	85,	122,	23,	139,	68,	130,	230,	90,	0,
+			67,	141,	106,	166,	53,	87,	183,	96,	0,
+			37,	71,	147,	165,	132,	98,	0,
+			120,	71,	203,	178,	219,	215,	227,	0,
+			194,	221,	11,	125,	40,	53,	0,
+			77,	97,	45,	125,	0,	0,
+			101,	37,	55,	24,	145,	42,	0,
+			74,	98,	65,	33,	178,	120,	0,
+			21,	95,	103,	110,	33,	0,
+			7,	119,	7,	30,	68,	0,
+			227,	16,	90,	183,	133,	0,
+			25,	166,	28,	18,	67,	0,
+			132,	156,	96,	106,	162,	0,
+			11,	20,	155,	104,	81,	0,
+			136,	127,	74,	85,	0,
+			98,	109,	79,	21,	0,
+			105,	96,	150,	52,	4,	0,
+			110,	19,	36,	143,	0,
+			28,	121,	11,	61,	0,
+			47,	152,	129,	0,
+			82,	132,	115,	37,	0,
+			100,	29,	78,	103,	0,
+			15,	51,	64,	73,	0,
+			90,	123,	48,	23,	0,
+			93,	153,	145,	159,	0,
+			101,	33,	72,	40,	0,
+			117,	51,	64,	117,	0,
+			87,	122,	71,	128,	0,
+			148,	119,	54,	78,	0,
+			124,	91,	139,	0,
+			152,	54,	101,	135,	0,
+			80,	104,	82,	117,	0,
+			117,	70,	41,	0,
+			45,	138,	115,	87,	0,
+			103,	143,	7,	0,
+			99,	78,	32,	108,	0,
+			58,	109,	98,	121,	0,
+			14,	89,	127,	0,
+		},
+		{
+			307,	19,	50,	369,	181,	216,	317,	288,	109,	17,	357,	215,	106,	242,	180,	330,	346,	1,	0,
+			76,	76,	73,	288,	144,	331,	331,	178,	295,	342,	217,	99,	354,	114,	331,	112,	0,	0,	0,
+			205,	250,	328,	332,	256,	161,	267,	160,	63,	129,	200,	88,	53,	131,	240,	205,	13,	0,	0,
+			276,	87,	0,	275,	199,	153,	56,	132,	305,	231,	341,	212,	304,	300,	271,	39,	357,	1,	0,
+			2,	0,	0,
+			33,	235,	23,	24,	218,	88,	0,	0,
+			94,	10,	144,	96,	26,	205,	118,	99,	0,
+			2,	113,	7,	67,	67,	133,	0,
+			186,	188,	209,	60,	48,	98,	198,	209,	30,	0,
+			85,	240,	63,	216,	102,	165,	85,	185,	0,
+			178,	147,	114,	170,	19,	174,	0,
+			129,	75,	128,	110,	69,	34,	53,	0,
+			119,	33,	151,	143,	127,	87,	0,
+			48,	126,	156,	97,	0,	0,
+			152,	94,	179,	71,	53,	110,	0,
+			197,	172,	147,	106,	54,	34,	0,
+			86,	128,	186,	158,	113,	0,
+			130,	158,	77,	31,	0,	0,
+			52,	80,	95,	61,	82,	0,
+			104,	204,	82,	187,	105,	0,
+			51,	87,	208,	123,	85,	0,
+			107,	144,	160,	110,	148,	0,
+			160,	109,	175,	38,	0,
+			60,	73,	176,	118,	0,
+			71,	47,	51,	5,	5,	0,
+			136,	46,	160,	163,	0,
+			133,	164,	55,	131,	0,
+			67,	2,	135,	0,
+			110,	140,	158,	116,	0,
+			54,	42,	61,	95,	0,
+			152,	116,	93,	122,	0,
+			31,	76,	57,	122,	0,
+			75,	157,	76,	5,	0,
+			77,	39,	77,	118,	0,
+			61,	62,	46,	69,	0,
+			107,	22,	42,	139,	0,
+			124,	42,	46,	125,	0,
+			91,	36,	101,	0,
+			17,	54,	35,	148,	0,
+			104,	95,	116,	94,	0,
+			124,	118,	112,	0,
+			119,	53,	83,	134,	0,
+			147,	42,	88,	0,
+			92,	56,	64,	104,	0,
+			99,	82,	132,	34,	0,
+			100,	120,	119,	0,
+		},
+		{
+			73,	15,	103,	49,	240,	39,	15,	162,	215,	164,	133,	298,	110,	113,	16,	189,	32,	1,	0,
+			303,	294,	27,	261,	161,	133,	4,	80,	129,	300,	76,	266,	72,	83,	260,	301,	0,	0,	0,
+			68,	7,	80,	280,	38,	227,	202,	200,	71,	106,	295,	283,	301,	184,	246,	230,	276,	0,	0,
+			220,	208,	30,	197,	61,	175,	79,	281,	303,	253,	164,	53,	44,	28,	77,	319,	68,	1,	0,
+			282,	0,	0,
+			301,	8,	66,	78,	194,	209,	0,	0,
+			62,	107,	221,	3,	70,	186,	225,	236,	0,
+			167,	150,	142,	95,	186,	221,	0,
+			227,	168,	59,	142,	207,	177,	36,	79,	108,	0,
+			104,	13,	208,	169,	56,	128,	135,	172,	0,
+			164,	82,	188,	186,	22,	8,	0,
+			191,	152,	54,	197,	99,	47,	169,	0,
+			126,	87,	10,	98,	87,	164,	0,
+			12,	121,	166,	88,	2,	0,
+			40,	90,	11,	161,	170,	16,	0,
+			30,	83,	147,	52,	191,	151,	0,
+			115,	85,	134,	166,	53,	0,
+			43,	18,	49,	141,	12,	0,
+			197,	112,	118,	85,	185,	0,
+			7,	59,	104,	164,	14,	0,
+			66,	88,	22,	70,	149,	0,
+			9,	140,	56,	159,	119,	0,
+			107,	148,	143,	163,	0,
+			194,	20,	70,	114,	0,
+			178,	185,	47,	75,	108,	0,
+			98,	69,	43,	50,	0,
+			12,	27,	30,	97,	0,
+			48,	39,	136,	0,
+			36,	119,	109,	125,	0,
+			21,	152,	76,	64,	0,
+			53,	116,	45,	127,	0,
+			90,	65,	12,	15,	0,
+			138,	64,	13,	37,	0,
+			22,	136,	35,	151,	0,
+			33,	26,	8,	52,	0,
+			97,	12,	80,	60,	0,
+			112,	35,	14,	6,	0,
+			15,	68,	65,	0,
+			25,	12,	17,	47,	0,
+			81,	25,	125,	98,	0,
+			118,	51,	43,	0,
+			26,	45,	62,	40,	0,
+			52,	47,	70,	0,
+			54,	48,	75,	41,	0,
+			43,	69,	52,	53,	0,
+			65,	106,	73,	0,
+		},
+		{
+			223,	16,	94,	91,	74,	10,	0,	205,	216,	21,	215,	14,	70,	141,	198,	104,	81,	1,	0,
+			141,	45,	151,	46,	119,	157,	133,	87,	206,	93,	79,	9,	118,	194,	31,	187,	0,	0,	0,
+			207,	203,	31,	176,	180,	186,	95,	153,	177,	70,	77,	214,	77,	198,	117,	223,	90,	0,	0,
+			201,	18,	165,	5,	45,	142,	16,	34,	155,	213,	147,	69,	96,	74,	99,	30,	158,	1,	0,
+			118,	0,	0,
+			11,	96,	143,	144,	22,	104,	0,	0,
+			189,	36,	43,	109,	34,	173,	84,	129,	0,
+			139,	163,	114,	207,	135,	59,	0,
+			101,	81,	193,	72,	132,	25,	126,	185,	154,	0,
+			192,	9,	109,	153,	52,	97,	96,	85,	0,
+			169,	75,	130,	188,	91,	192,	0,
+			134,	94,	174,	182,	22,	50,	31,	0,
+			183,	155,	41,	209,	107,	92,	0,
+			186,	63,	42,	25,	0,	0,
+			84,	46,	34,	170,	94,	27,	0,
+			76,	133,	114,	122,	162,	110,	0,
+			123,	82,	145,	10,	152,	0,
+			121,	120,	51,	40,	79,	0,
+			41,	72,	23,	104,	10,	0,
+			60,	81,	45,	55,	52,	0,
+			180,	144,	107,	83,	8,	0,
+			131,	122,	110,	105,	6,	0,
+			71,	135,	50,	26,	0,
+			46,	126,	61,	35,	0,
+			81,	88,	35,	128,	167,	0,
+			109,	127,	117,	156,	0,
+			6,	80,	122,	54,	0,
+			88,	14,	47,	0,
+			130,	151,	110,	25,	0,
+			140,	114,	150,	100,	0,
+			147,	60,	55,	17,	0,
+			80,	116,	149,	66,	0,
+			73,	71,	138,	9,	0,
+			69,	119,	82,	9,	0,
+			64,	140,	11,	11,	0,
+			101,	121,	40,	94,	0,
+			82,	38,	129,	82,	0,
+			110,	46,	80,	0,
+			80,	79,	99,	91,	0,
+			84,	51,	101,	7,	0,
+			46,	4,	27,	0,
+			73,	59,	84,	103,	0,
+			11,	18,	15,	0,
+			53,	120,	26,	89,	0,
+			108,	57,	108,	21,	0,
+			78,	43,	104,	0,
+		},
+		{
+			211,	198,	188,	186,	219,	4,	29,	144,	116,	216,	115,	233,	144,	95,	216,	73,	261,	1,	0,
+			179,	162,	223,	256,	160,	76,	202,	117,	109,	15,	72,	152,	158,	147,	156,	119,	0,	0,	0,
+			258,	167,	220,	133,	243,	202,	218,	63,	0,	3,	74,	229,	0,	216,	269,	200,	234,	0,	0,
+			187,	145,	166,	108,	82,	132,	197,	164,	159,	57,	36,	115,	242,	165,	0,	113,	108,	1,	0,
+			260,	0,	0,
+			127,	95,	133,	63,	76,	228,	0,	0,
+			168,	34,	238,	8,	42,	106,	221,	130,	0,
+			22,	163,	68,	47,	193,	33,	0,
+			110,	186,	31,	34,	98,	71,	112,	68,	222,	0,
+			200,	190,	99,	49,	37,	174,	53,	200,	0,
+			100,	141,	54,	88,	135,	172,	0,
+			65,	127,	135,	107,	172,	101,	206,	0,
+			16,	106,	27,	151,	103,	95,	0,
+			31,	138,	140,	171,	4,	0,
+			28,	39,	62,	127,	131,	58,	0,
+			149,	156,	53,	141,	93,	105,	0,
+			84,	96,	30,	159,	2,	0,
+			63,	161,	59,	145,	9,	0,
+			68,	162,	168,	26,	42,	0,
+			144,	114,	126,	134,	115,	0,
+			169,	105,	77,	40,	74,	0,
+			17,	144,	39,	166,	169,	0,
+			32,	164,	65,	50,	0,
+			56,	148,	80,	140,	0,
+			74,	169,	92,	126,	61,	0,
+			84,	139,	76,	102,	0,
+			47,	60,	115,	44,	0,
+			44,	71,	111,	0,
+			82,	70,	100,	95,	0,
+			27,	59,	31,	105,	0,
+			127,	107,	97,	12,	0,
+			117,	19,	5,	98,	0,
+			95,	112,	74,	90,	0,
+			13,	88,	40,	68,	0,
+			21,	24,	7,	125,	0,
+			5,	105,	88,	4,	0,
+			110,	81,	29,	7,	0,
+			36,	22,	74,	0,
+			48,	109,	28,	37,	0,
+			75,	51,	8,	21,	0,
+			43,	56,	44,	0,
+			128,	40,	53,	78,	0,
+			104,	22,	32,	0,
+			75,	126,	104,	30,	0,
+			6,	30,	113,	16,	0,
+			130,	112,	122,	0,
+		},
+		{
+			294,	118,	167,	330,	207,	165,	243,	250,	1,	339,	201,	53,	347,	304,	167,	47,	188,	1,	0,
+			77,	225,	96,	338,	268,	112,	302,	50,	167,	253,	334,	242,	257,	133,	9,	302,	0,	0,	0,
+			226,	35,	213,	302,	111,	265,	128,	237,	294,	127,	110,	286,	125,	131,	163,	210,	7,	0,	0,
+			97,	94,	49,	279,	139,	166,	91,	106,	246,	345,	269,	185,	249,	215,	143,	121,	121,	1,	0,
+			28,	0,	0,
+			8,	72,	123,	82,	168,	98,	0,	0,
+			154,	47,	53,	211,	134,	33,	18,	147,	0,
+			211,	118,	132,	109,	76,	60,	0,
+			203,	43,	202,	41,	154,	91,	194,	43,	11,	0,
+			182,	47,	111,	88,	74,	96,	146,	189,	0,
+			106,	30,	93,	172,	64,	152,	0,
+			78,	199,	40,	185,	108,	188,	15,	0,
+			163,	39,	124,	118,	135,	83,	0,
+			148,	122,	48,	9,	40,	0,
+			118,	110,	152,	10,	106,	144,	0,
+			99,	52,	15,	60,	122,	182,	0,
+			170,	183,	148,	35,	115,	0,
+			23,	54,	44,	77,	59,	0,
+			81,	143,	92,	78,	26,	0,
+			70,	169,	19,	63,	25,	0,
+			37,	138,	88,	103,	63,	0,
+			97,	148,	71,	92,	52,	0,
+			146,	80,	38,	84,	0,
+			30,	113,	43,	8,	0,
+			121,	135,	60,	43,	47,	0,
+			16,	58,	6,	12,	0,
+			16,	104,	82,	138,	0,
+			149,	119,	20,	0,
+			84,	31,	132,	138,	0,
+			150,	6,	33,	141,	0,
+			26,	86,	91,	121,	0,
+			142,	142,	48,	36,	0,
+			91,	33,	22,	58,	0,
+			99,	76,	37,	48,	0,
+			40,	52,	46,	87,	0,
+			122,	29,	41,	102,	0,
+			96,	45,	24,	56,	0,
+			103,	61,	140,	0,
+			14,	47,	51,	120,	0,
+			76,	98,	112,	83,	0,
+			127,	25,	31,	0,
+			117,	85,	47,	44,	0,
+			63,	26,	50,	0,
+			106,	117,	12,	63,	0,
+			70,	90,	110,	111,	0,
+			73,	66,	44,	0,
+		},
+		{
+			0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,	0,
+			22,	11,	124,	0,	10,	0,	0,	2,	16,	60,	0,	6,	30,	0,	168,	31,	105,	0,	0,
+			132,	37,	21,	180,	4,	149,	48,	38,	122,	195,	155,	28,	85,	47,	179,	42,	66,	0,	0,
+			4,	6,	33,	113,	49,	21,	6,	151,	83,	154,	87,	5,	92,	173,	120,	2,	142,	0,	0,
+			0,	0,	0,
+			4,	29,	19,	2,	144,	11,	0,	0,
+			103,	161,	11,	81,	134,	30,	107,	93,	0,
+			136,	95,	9,	76,	111,	116,	0,
+			135,	78,	24,	106,	86,	62,	42,	147,	94,	0,
+			144,	14,	112,	102,	115,	19,	44,	113,	0,
+			119,	97,	25,	43,	135,	149,	0,
+			113,	133,	91,	63,	30,	12,	114,	0,
+			171,	106,	11,	47,	56,	32,	0,
+			132,	50,	43,	98,	102,	0,
+			70,	86,	90,	136,	34,	55,	0,
+			4,	83,	168,	12,	13,	46,	0,
+			96,	119,	146,	102,	66,	0,
+			55,	117,	62,	21,	61,	0,
+			108,	74,	16,	108,	50,	0,
+			38,	63,	103,	91,	89,	0,
+			38,	94,	45,	74,	106,	0,
+			90,	42,	46,	129,	34,	0,
+			77,	98,	102,	12,	0,
+			129,	122,	21,	101,	0,
+			14,	51,	68,	71,	12,	0,
+			2,	56,	86,	112,	0,
+			84,	128,	70,	66,	0,
+			120,	44,	102,	0,
+			0,	56,	3,	107,	0,
+			129,	65,	112,	36,	0,
+			48,	36,	141,	43,	0,
+			110,	102,	67,	23,	0,
+			24,	77,	52,	85,	0,
+			70,	65,	115,	11,	0,
+			11,	107,	14,	6,	0,
+			52,	41,	71,	39,	0,
+			89,	37,	100,	28,	0,
+			77,	84,	23,	0,
+			29,	71,	57,	1,	0,
+			64,	71,	106,	117,	0,
+			8,	101,	103,	0,
+			42,	75,	113,	90,	0,
+			41,	10,	76,	0,
+			64,	41,	66,	116,	0,
+			113,	59,	34,	77,	0,
+			40,	97,	104,	0,
+		},
+		{
+			135,	227,	126,	134,	84,	83,	53,	225,	205,	128,	75,	135,	217,	220,	90,	105,	137,	1,	0,
+			96,	236,	136,	221,	128,	92,	172,	56,	11,	189,	95,	85,	153,	87,	163,	216,	0,	0,	0,
+			189,	4,	225,	151,	236,	117,	179,	92,	24,	68,	6,	101,	33,	96,	125,	67,	230,	0,	0,
+			128,	23,	162,	220,	43,	186,	96,	1,	216,	22,	24,	167,	200,	32,	235,	172,	219,	1,	0,
+			23,	0,	0,
+			141,	43,	162,	62,	139,	26,	0,	0,
+			166,	132,	102,	88,	81,	109,	88,	95,	0,
+			137,	101,	74,	79,	58,	183,	0,
+			40,	146,	123,	70,	114,	197,	227,	46,	176,	0,
+			10,	132,	101,	37,	37,	58,	154,	100,	0,
+			212,	138,	215,	125,	43,	33,	0,
+			3,	176,	201,	107,	178,	66,	97,	0,
+			170,	177,	101,	21,	154,	128,	0,
+			126,	120,	94,	68,	36,	0,
+			175,	166,	51,	76,	87,	164,	0,
+			192,	145,	155,	13,	166,	114,	0,
+			227,	189,	65,	201,	123,	0,
+			146,	20,	10,	61,	92,	0,
+			156,	101,	22,	16,	131,	0,
+			9,	57,	149,	43,	142,	0,
+			117,	98,	93,	101,	162,	0,
+			8,	96,	98,	90,	23,	0,
+			176,	67,	73,	126,	0,
+			115,	101,	94,	18,	0,
+			153,	122,	161,	86,	48,	0,
+			131,	115,	105,	87,	0,
+			93,	8,	53,	128,	0,
+			49,	118,	66,	0,
+			25,	101,	39,	104,	0,
+			54,	47,	112,	47,	0,
+			158,	34,	34,	79,	0,
+			115,	44,	133,	36,	0,
+			123,	149,	17,	4,	0,
+			38,	86,	75,	95,	0,
+			1,	58,	28,	111,	0,
+			39,	98,	34,	90,	0,
+			104,	111,	68,	5,	0,
+			53,	45,	112,	0,
+			99,	28,	97,	121,	0,
+			20,	28,	83,	64,	0,
+			130,	101,	102,	0,
+			35,	50,	114,	86,	0,
+			104,	127,	34,	0,
+			73,	27,	29,	55,	0,
+			56,	88,	76,	67,	0,
+			84,	45,	12,	0,
+		},
+	};
+};
+
+// sized like BG2 with its double diagonal core, 42 rows, 52 columns and up to 10 links per row, but these are not the shift values of 3GPP TS 38.212
+struct BG2_LIKE_BASE_GRAPH
+{
+	static const int ROWS = 42;
+	static const int COLS = 52;
+	static const int LINKS = 197;
+	static const int DEG_MAX = 10;
+	static constexpr int DEG[] = {
+		8, 10, 8, 10, 4, 6, 6, 6, 4, 5, 5, 5, 4, 5, 5, 4,
+		5, 5, 4, 4, 4, 4, 3, 4, 4, 3, 5, 3, 4, 3, 5, 3,
+		4, 4, 4, 4, 4, 3, 4, 4, 4, 4
+	};
+	static constexpr int POS[] = {
+		0,	1,	2,	3,	6,	9,	10,	11,
+		0,	3,	4,	5,	6,	7,	8,	9,	11,	12,
+		0,	1,	3,	4,	8,	10,	12,	13,
+		1,	2,	4,	5,	6,	7,	8,	9,	10,	13,
+		0,	1,	11,	14,
+		0,	1,	5,	7,	11,	15,
+		0,	5,	7,	9,	11,	16,
+		1,	5,	7,	11,	13,	17,
+		0,	1,	12,	18,
+		1,	8,	10,	11,	19,
+		0,	1,	6,	7,	20,
+		0,	7,	9,	13,	21,
+		1,	3,	11,	22,
+		0,	1,	8,	13,	23,
+		1,	6,	11,	13,	24,
+		0,	10,	11,	25,
+		1,	9,	11,	12,	26,
+		1,	5,	11,	12,	27,
+		0,	6,	7,	28,
+		0,	1,	10,	29,
+		1,	4,	11,	30,
+		0,	8,	13,	31,
+		1,	2,	32,
+		0,	3,	5,	33,
+		1,	2,	9,	34,
+		0,	5,	35,
+		2,	7,	12,	13,	36,
+		0,	6,	37,
+		1,	2,	5,	38,
+		0,	4,	39,
+		2,	5,	7,	9,	40,
+		1,	13,	41,
+		0,	5,	12,	42,
+		2,	7,	10,	43,
+		0,	12,	13,	44,
+		1,	5,	11,	45,
+		0,	2,	7,	46,
+		10,	13,	47,
+		1,	5,	11,	48,
+		0,	7,	12,	49,
+		2,	10,	13,	50,
+		1,	5,	11,	51,
+	};
+	static constexpr int SHI[8][LINKS] = {
+		{
+			9,	117,	204,	26,	189,	205,	0,	0,
+			167,	166,	253,	125,	226,	156,	224,	252,	0,	0,
+			81,	114,	44,	52,	240,	1,	0,	0,
+			8,	58,	158,	104,	209,	54,	18,	128,	0,	0,
+			179,	214,	71,	0,
+			231,	41,	194,	159,	103,	0,
+			155,	228,	45,	28,	158,	0,
+			129,	147,	140,	3,	116,	0,
+			142,	94,	230,	0,
+			203,	205,	61,	247,	0,
+			11,	185,	0,	117,	0,
+			11,	236,	210,	56,	0,
+			63,	111,	14,	0,
+			83,	2,	38,	222,	0,
+			115,	145,	3,	232,	0,
+			51,	175,	213,	0,
+			203,	142,	8,	242,	0,
+			254,	124,	114,	64,	0,
+			220,	194,	50,	0,
+			87,	20,	185,	0,
+			26,	105,	29,	0,
+			76,	42,	210,	0,
+			222,	63,	0,
+			23,	235,	238,	0,
+			46,	139,	8,	0,
+			228,	156,	0,
+			29,	143,	160,	122,	0,
+			8,	151,	0,
+			98,	101,	135,	0,
+			18,	28,	0,
+			71,	240,	9,	84,	0,
+			106,	1,	0,
+			242,	44,	166,	0,
+			132,	164,	235,	0,
+			147,	85,	36,	0,
+			57,	40,	63,	0,
+			140,	38,	154,	0,
+			219,	151,	0,
+			31,	66,	38,	0,
+			239,	172,	34,	0,
+			0,	75,	120,	0,
+			129,	229,	118,	0,
+		},
+		{
+			174,	97,	166,	66,	71,	172,	0,	0,
+			27,	36,	48,	92,	31,	187,	185,	3,	0,	0,
+			25,	114,	117,	110,	114,	1,	0,	0,
+			136,	175,	113,	72,	123,	118,	28,	186,	0,	0,
+			72,	74,	29,	0,
+			10,	44,	121,	80,	48,	0,
+			129,	92,	100,	49,	184,	0,
+			80,	186,	16,	102,	143,	0,
+			118,	70,	152,	0,
+			28,	132,	185,	178,	0,
+			59,	104,	22,	52,	0,
+			32,	92,	174,	154,	0,
+			39,	93,	11,	0,
+			49,	125,	35,	166,	0,
+			19,	118,	21,	163,	0,
+			68,	63,	81,	0,
+			87,	177,	135,	64,	0,
+			158,	23,	9,	6,	0,
+			186,	6,	46,	0,
+			58,	42,	156,	0,
+			76,	61,	153,	0,
+			157,	175,	67,	0,
+			20,	52,	0,
+			106,	86,	95,	0,
+			182,	153,	64,	0,
+			45,	21,	0,
+			67,	137,	55,	85,	0,
+			103,	50,	0,
+			70,	111,	168,	0,
+			110,	17,	0,
+			120,	154,	52,	56,	0,
+			3,	170,	0,
+			84,	8,	17,	0,
+			165,	179,	124,	0,
+			173,	177,	12,	0,
+			77,	184,	18,	0,
+			25,	151,	170,	0,
+			37,	31,	0,
+			84,	151,	190,	0,
+			93,	132,	57,	0,
+			103,	107,	163,	0,
+			147,	7,	60,	0,
+		},
+		{
+			0,	0,	0,	0,	0,	0,	0,	0,
+			137,	124,	0,	0,	88,	0,	0,	55,	0,	0,
+			20,	94,	99,	9,	108,	1,	0,	0,
+			38,	15,	102,	146,	12,	57,	53,	46,	0,	0,
+			0,	136,	157,	0,
+			0,	131,	142,	141,	64,	0,
+			0,	124,	99,	45,	148,	0,
+			0,	45,	148,	96,	78,	0,
+			0,	65,	87,	0,
+			0,	97,	51,	85,	0,
+			0,	17,	156,	20,	0,
+			0,	7,	4,	2,	0,
+			0,	113,	48,	0,
+			0,	112,	102,	26,	0,
+			0,	138,	57,	27,	0,
+			0,	73,	99,	0,
+			0,	79,	111,	143,	0,
+			0,	24,	109,	18,	0,
+			0,	18,	86,	0,
+			0,	158,	154,	0,
+			0,	148,	104,	0,
+			0,	17,	33,	0,
+			0,	4,	0,
+			0,	75,	158,	0,
+			0,	69,	87,	0,
+			0,	65,	0,
+			0,	100,	13,	7,	0,
+			0,	32,	0,
+			0,	126,	110,	0,
+			0,	154,	0,
+			0,	35,	51,	134,	0,
+			0,	20,	0,
+			0,	20,	122,	0,
+			0,	88,	13,	0,
+			0,	19,	78,	0,
+			0,	157,	6,	0,
+			0,	63,	82,	0,
+			0,	144,	0,
+			0,	93,	19,	0,
+			0,	24,	138,	0,
+			0,	36,	143,	0,
+			0,	2,	55,	0,
+		},
+		{
+			72,	110,	23,	181,	95,	8,	1,	0,
+			53,	156,	115,	156,	115,	200,	29,	31,	0,	0,
+			152,	131,	46,	191,	91,	0,	0,	0,
+			185,	6,	36,	124,	124,	110,	156,	133,	1,	0,
+			200,	16,	101,	0,
+			185,	138,	170,	219,	193,	0,
+			123,	55,	31,	222,	209,	0,
+			103,	13,	105,	150,	181,	0,
+			147,	43,	152,	0,
+			2,	30,	184,	83,	0,
+			174,	150,	8,	56,	0,
+			99,	138,	110,	99,	0,
+			46,	217,	109,	0,
+			37,	113,	143,	140,	0,
+			36,	95,	40,	116,	0,
+			116,	200,	110,	0,
+			75,	158,	134,	97,	0,
+			48,	132,	206,	2,	0,
+			68,	16,	156,	0,
+			35,	138,	86,	0,
+			6,	20,	141,	0,
+			80,	43,	81,	0,
+			49,	1,	0,
+			156,	54,	134,	0,
+			153,	88,	63,	0,
+			211,	94,	0,
+			90,	6,	221,	6,	0,
+			27,	118,	0,
+			216,	212,	193,	0,
+			108,	61,	0,
+			106,	44,	185,	176,	0,
+			147,	182,	0,
+			108,	21,	110,	0,
+			71,	12,	109,	0,
+			29,	201,	69,	0,
+			91,	165,	55,	0,
+			1,	175,	83,	0,
+			40,	12,	0,
+			37,	97,	46,	0,
+			106,	181,	154,	0,
+			98,	35,	36,	0,
+			120,	101,	81,	0,
+		},
+		{
+			3,	26,	53,	35,	115,	127,	0,	0,
+			19,	94,	104,	66,	84,	98,	69,	50,	0,	0,
+			95,	106,	92,	110,	111,	1,	0,	0,
+			120,	121,	22,	4,	73,	49,	128,	79,	0,	0,
+			42,	24,	51,	0,
+			40,	140,	84,	137,	71,	0,
+			109,	87,	107,	133,	139,	0,
+			97,	135,	35,	108,	65,	0,
+			70,	69,	88,	0,
+			97,	40,	24,	49,	0,
+			46,	41,	101,	96,	0,
+			28,	30,	116,	64,	0,
+			33,	122,	131,	0,
+			76,	37,	62,	47,	0,
+			143,	51,	130,	97,	0,
+			139,	96,	128,	0,
+			48,	9,	28,	8,	0,
+			120,	43,	65,	42,	0,
+			17,	106,	142,	0,
+			79,	28,	41,	0,
+			2,	103,	78,	0,
+			91,	75,	81,	0,
+			54,	132,	0,
+			68,	115,	56,	0,
+			30,	42,	101,	0,
+			128,	63,	0,
+			142,	28,	100,	133,	0,
+			13,	10,	0,
+			106,	77,	43,	0,
+			133,	25,	0,
+			87,	56,	104,	70,	0,
+			80,	139,	0,
+			32,	89,	71,	0,
+			135,	6,	2,	0,
+			37,	25,	114,	0,
+			60,	137,	93,	0,
+			121,	129,	26,	0,
+			97,	56,	0,
+			1,	70,	1,	0,
+			119,	32,	142,	0,
+			6,	73,	102,	0,
+			48,	47,	19,	0,
+		},
+		{
+			156,	143,	14,	3,	40,	123,	0,	0,
+			17,	65,	63,	1,	55,	37,	171,	133,	0,	0,
+			98,	168,	107,	82,	142,	1,	0,	0,
+			53,	174,	174,	127,	17,	89,	17,	105,	0,	0,
+			86,	67,	83,	0,
+			79,	84,	35,	103,	60,	0,
+			47,	154,	10,	155,	29,	0,
+			48,	125,	24,	47,	55,	0,
+			53,	31,	161,	0,
+			104,	142,	99,	64,	0,
+			111,	25,	174,	23,	0,
+			91,	175,	24,	141,	0,
+			122,	11,	4,	0,
+			29,	91,	27,	127,	0,
+			11,	145,	8,	166,	0,
+			137,	103,	40,	0,
+			78,	158,	17,	165,	0,
+			134,	23,	62,	163,	0,
+			173,	31,	22,	0,
+			13,	135,	145,	0,
+			128,	52,	173,	0,
+			156,	166,	40,	0,
+			18,	163,	0,
+			110,	132,	150,	0,
+			113,	108,	61,	0,
+			72,	136,	0,
+			36,	38,	53,	145,	0,
+			42,	104,	0,
+			64,	24,	149,	0,
+			139,	161,	0,
+			84,	173,	93,	29,	0,
+			117,	148,	0,
+			116,	73,	142,	0,
+			105,	137,	29,	0,
+			11,	41,	162,	0,
+			126,	152,	172,	0,
+			73,	154,	129,	0,
+			167,	38,	0,
+			112,	7,	19,	0,
+			109,	6,	105,	0,
+			160,	156,	82,	0,
+			132,	6,	8,	0,
+		},
+		{
+			143,	19,	176,	165,	196,	13,	0,	0,
+			18,	27,	3,	102,	185,	17,	14,	180,	0,	0,
+			126,	163,	47,	183,	132,	1,	0,	0,
+			36,	48,	18,	111,	203,	3,	191,	160,	0,	0,
+			43,	27,	117,	0,
+			136,	49,	36,	132,	62,	0,
+			7,	34,	198,	168,	12,	0,
+			163,	78,	143,	107,	58,	0,
+			101,	177,	22,	0,
+			186,	27,	205,	81,	0,
+			125,	60,	177,	51,	0,
+			39,	29,	35,	8,	0,
+			18,	155,	49,	0,
+			32,	53,	95,	186,	0,
+			91,	20,	52,	109,	0,
+			174,	108,	102,	0,
+			125,	31,	54,	176,	0,
+			57,	201,	142,	35,	0,
+			129,	203,	140,	0,
+			110,	124,	52,	0,
+			196,	35,	114,	0,
+			10,	122,	23,	0,
+			202,	126,	0,
+			52,	170,	13,	0,
+			113,	161,	88,	0,
+			197,	194,	0,
+			164,	172,	49,	161,	0,
+			168,	193,	0,
+			14,	186,	46,	0,
+			50,	27,	0,
+			70,	17,	50,	6,	0,
+			115,	189,	0,
+			110,	0,	163,	0,
+			163,	173,	179,	0,
+			197,	191,	193,	0,
+			157,	167,	181,	0,
+			197,	167,	179,	0,
+			181,	193,	0,
+			157,	173,	191,	0,
+			181,	157,	173,	0,
+			193,	163,	179,	0,
+			191,	197,	167,	0,
+		},
+		{
+			145,	131,	71,	21,	23,	112,	1,	0,
+			142,	174,	183,	27,	96,	23,	9,	167,	0,	0,
+			74,	31,	3,	53,	155,	0,	0,	0,
+			239,	171,	95,	110,	159,	199,	43,	75,	1,	0,
+			29,	140,	180,	0,
+			121,	41,	169,	88,	207,	0,
+			137,	72,	172,	124,	56,	0,
+			86,	186,	87,	172,	154,	0,
+			176,	169,	225,	0,
+			167,	238,	48,	68,	0,
+			38,	217,	208,	232,	0,
+			178,	214,	168,	51,	0,
+			124,	122,	72,	0,
+			48,	57,	167,	219,	0,
+			82,	232,	204,	162,	0,
+			38,	217,	157,	0,
+			170,	23,	175,	202,	0,
+			196,	173,	195,	218,	0,
+			128,	211,	210,	0,
+			39,	84,	88,	0,
+			117,	227,	6,	0,
+			238,	13,	11,	0,
+			195,	44,	0,
+			5,	94,	111,	0,
+			81,	19,	130,	0,
+			66,	95,	0,
+			146,	66,	190,	86,	0,
+			64,	181,	0,
+			7,	144,	16,	0,
+			25,	57,	0,
+			37,	139,	221,	17,	0,
+			201,	46,	0,
+			179,	14,	116,	0,
+			46,	2,	106,	0,
+			184,	135,	141,	0,
+			85,	225,	175,	0,
+			178,	112,	106,	0,
+			154,	114,	0,
+			42,	41,	105,	0,
+			167,	45,	189,	0,
+			78,	67,	180,	0,
+			53,	215,	230,	0,
+		},
+	};
+};
+
+template <typename TABLE>
+void ldpc_nr_test(const int *sizes, int len)
+{
+	const int TRIALS = 25;
+	const int FACTOR = 2;
+	const int COLS = TABLE::COLS, ROWS = TABLE::ROWS, KB = COLS - ROWS;
+	const int Z_MAX = CODE::LDPCNRLifting::Z_MAX;
+	CODE::LDPCNREncoder<TABLE> encode;
+	typedef CODE::LDPCNRDecoder<TABLE, 1> DECODER;
+	DECODER *decode = new DECODER();
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::normal_distribution<float> normal;
+	int8_t *code = new int8_t[COLS * Z_MAX];
+	int8_t *orig = new int8_t[COLS * Z_MAX];
+	for (int s = 0; s < len; ++s) {
+		int Z = sizes[s];
+		int N = COLS * Z;
+		for (int frame = 0; frame < 4; ++frame) {
+			for (int i = 0; i < KB * Z; ++i)
+				code[i] = 1 - 2 * (generator() & 1);
+			encode(code, Z);
+			for (int r = 0, e = 0; r < ROWS; e += TABLE::DEG[r++]) {
+				int set = CODE::LDPCNRLifting::set(Z);
+				for (int z = 0; z < Z; ++z) {
+					int8_t parity = 1;
+					for (int d = 0; d < TABLE::DEG[r]; ++d)
+						parity *= code[Z * TABLE::POS[e+d] + (z + TABLE::SHI[set][e+d]) % Z];
+					assert(parity == 1);
+				}
+			}
+			for (int i = 0; i < N; ++i)
+				orig[i] = code[i];
+			float SNR = 6;
+			float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+			auto awgn = std::bind(normal(0, sigma_noise), generator);
+			float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+			for (int i = 0; i < N; ++i)
+				code[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (code[i] + awgn())), -127), 127);
+			// like NR, the first two columns are never transmitted
+			if (frame & 1)
+				for (int i = 0; i < 2 * Z; ++i)
+					code[i] = 0;
+			int count = (*decode)(code, Z, TRIALS);
+			assert(count >= 0);
+			for (int i = 0; i < N; ++i)
+				assert(code[i] * orig[i] > 0);
+		}
+	}
+	delete[] code;
+	delete[] orig;
+	delete decode;
+}
+
+// dimensions and diagonals of the base graph, with the shift values of every set below the largest lifting size of that set
+template <typename TABLE>
+void ldpc_nr_structure_test()
+{
+	const int COLS = TABLE::COLS, ROWS = TABLE::ROWS, KB = COLS - ROWS;
+	const int Z_MAX = CODE::LDPCNRLifting::Z_MAX;
+	int links = 0;
+	for (int r = 0, e = 0; r < ROWS; e += TABLE::DEG[r++]) {
+		assert(TABLE::DEG[r] <= TABLE::DEG_MAX);
+		for (int d = 0; d < TABLE::DEG[r]; ++d) {
+			assert(!d || TABLE::POS[e+d-1] < TABLE::POS[e+d]);
+			for (int set = 0; set < CODE::LDPCNRLifting::SETS; ++set) {
+				int z = Z_MAX;
+				while (CODE::LDPCNRLifting::set(z) != set)
+					--z;
+				assert(TABLE::SHI[set][e+d] < z);
+			}
+		}
+		// below the core every row gets a parity column of its own on the diagonal
+		if (r >= 4) {
+			assert(TABLE::POS[e+TABLE::DEG[r]-1] == KB + r);
+			for (int set = 0; set < CODE::LDPCNRLifting::SETS; ++set)
+				assert(TABLE::SHI[set][e+TABLE::DEG[r]-1] == 0);
+		}
+		for (int d = 0; d < TABLE::DEG[r] - (r >= 4); ++d)
+			assert(TABLE::POS[e+d] < KB + 4);
+		links += TABLE::DEG[r];
+	}
+	assert(links == TABLE::LINKS);
+}
+
+int main()
+{
+	assert(CODE::LDPCNRLifting::set(1) < 0 && CODE::LDPCNRLifting::set(17) < 0 && CODE::LDPCNRLifting::set(416) < 0);
+	assert(CODE::LDPCNRLifting::set(384) == 1 && CODE::LDPCNRLifting::set(208) == 6);
+	// below, within and above the SIMD width, from every set of shift values
+	const int sizes[] = { 2, 3, 5, 7, 9, 11, 13, 15, 16, 30, 32, 36, 52, 104, 176, 240, 256, 384 };
+	ldpc_nr_test<TOY_BASE_GRAPH>(sizes, sizeof(sizes) / sizeof(*sizes));
+	ldpc_nr_structure_test<BG1_LIKE_BASE_GRAPH>();
+	ldpc_nr_structure_test<BG2_LIKE_BASE_GRAPH>();
+	// at least one lifting size from every set, including the largest of each
+	const int nr_sizes[] = { 4, 256, 6, 384, 10, 320, 14, 224, 18, 288, 22, 352, 26, 208, 30, 240 };
+	ldpc_nr_test<BG1_LIKE_BASE_GRAPH>(nr_sizes, sizeof(nr_sizes) / sizeof(*nr_sizes));
+	ldpc_nr_test<BG2_LIKE_BASE_GRAPH>(nr_sizes, sizeof(nr_sizes) / sizeof(*nr_sizes));
+	std::cerr << "5G NR like LDPC code regression test passed!" << std::endl;
+	return 0;
+}
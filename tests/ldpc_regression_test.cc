@@ -14,8 +14,14 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 #include <chrono>
 #include <algorithm>
 #include <functional>
+#include <sstream>
 #include "ldpc_encoder.hh"
+#include "ldpc_packed_encoder.hh"
 #include "ldpc_decoder.hh"
+#include "ldpc_compact_decoder.hh"
+#include "ldpc_inter_decoder.hh"
+#include "ldpc_runtime_decoder.hh"
+#include "ldpc_pipeline.hh"
 
 struct DVB_T2_TABLE_A1
 {
@@ -527,6 +533,29 @@ static const float QEF_SNR = 2.5;
 static const int BCH_T = 12;
 #endif
 
+template <typename TABLE>
+void packed_encoder_test()
+{
+	const int N = TABLE::N, K = TABLE::K;
+	CODE::LDPCEncoder<TABLE> encode;
+	CODE::LDPCPackedEncoder<TABLE> packed;
+	int8_t *code = new int8_t[N];
+	uint8_t *bits = new uint8_t[N / 8];
+	std::default_random_engine generator(K);
+	for (int loop = 0; loop < 10; ++loop) {
+		for (int i = 0; i < K / 8; ++i)
+			bits[i] = generator();
+		for (int i = 0; i < K; ++i)
+			code[i] = 1 - 2 * ((bits[i/8] >> (7 - i%8)) & 1);
+		encode(code, code + K);
+		packed(bits, bits + K / 8);
+		for (int i = K; i < N; ++i)
+			assert(code[i] == 1 - 2 * ((bits[i/8] >> (7 - i%8)) & 1));
+	}
+	delete[] code;
+	delete[] bits;
+}
+
 int main()
 {
 	const int TRIALS = 25;
@@ -629,13 +658,249 @@ int main()
 		}
 	}
 
+	std::cerr << "QEF at: " << min_SNR << " SNR, speed min: " << min_mbs << " Mb/s and speed max: " << max_mbs << " Mb/s." << std::endl;
+	assert(min_SNR < QEF_SNR);
+
+	if (1) {
+		// a batch of frames above QEF, decoded side by side in the SIMD lanes
+		typedef CODE::LDPCInterDecoder<TABLE, BETA> INTER;
+		INTER *inter = new INTER();
+		const int FRAMES = INTER::FRAMES;
+		int8_t *codes = new int8_t[FRAMES * CODE_LEN];
+		int8_t *origs = new int8_t[FRAMES * CODE_LEN];
+		int results[FRAMES];
+
+		float SNR = QEF_SNR + 0.5;
+		float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+		auto data = std::bind(uniform(0, 1), generator);
+		auto awgn = std::bind(normal(0, sigma_noise), generator);
+		float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+
+		for (int n = 0; n < FRAMES; ++n) {
+			int8_t *frame = codes + CODE_LEN * n;
+			for (int i = 0; i < DATA_LEN; ++i)
+				frame[i] = 1 - 2 * data();
+			encode(frame, frame + DATA_LEN);
+			for (int i = 0; i < CODE_LEN; ++i)
+				origs[CODE_LEN * n + i] = frame[i];
+			for (int i = 0; i < CODE_LEN; ++i)
+				frame[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (frame[i] + awgn())), -127), 127);
+		}
+
+		auto start = std::chrono::system_clock::now();
+		int count = (*inter)(codes, FRAMES, results, TRIALS);
+		auto end = std::chrono::system_clock::now();
+		auto usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+		float mbs = (float)FRAMES * DATA_LEN / usec.count();
+
+		assert(count >= 0);
+		for (int n = 0; n < FRAMES; ++n) {
+			assert(results[n] >= 0);
+			int uncorrected_errors = 0;
+			for (int i = 0; i < CODE_LEN; ++i)
+				uncorrected_errors += codes[CODE_LEN * n + i] * origs[CODE_LEN * n + i] <= 0;
+			assert(uncorrected_errors <= BCH_T);
+		}
+		std::cerr << FRAMES << " frames decoded at once with " << mbs << " Mb/s." << std::endl;
+
+		delete[] codes;
+		delete[] origs;
+		delete inter;
+	}
+
+	if (1) {
+		// one decoder for all codes, switching the code with every frame
+		const CODE::LDPCRuntimeTable tables[4] = {
+			CODE::LDPCRuntimeTable(DVB_T2_TABLE_A1::M, DVB_T2_TABLE_A1::N, DVB_T2_TABLE_A1::K, DVB_T2_TABLE_A1::DEG, DVB_T2_TABLE_A1::LEN, DVB_T2_TABLE_A1::POS),
+			CODE::LDPCRuntimeTable(DVB_T2_TABLE_A3::M, DVB_T2_TABLE_A3::N, DVB_T2_TABLE_A3::K, DVB_T2_TABLE_A3::DEG, DVB_T2_TABLE_A3::LEN, DVB_T2_TABLE_A3::POS),
+			CODE::LDPCRuntimeTable(DVB_T2_TABLE_A6::M, DVB_T2_TABLE_A6::N, DVB_T2_TABLE_A6::K, DVB_T2_TABLE_A6::DEG, DVB_T2_TABLE_A6::LEN, DVB_T2_TABLE_A6::POS),
+			CODE::LDPCRuntimeTable(DVB_T2_TABLE_B7::M, DVB_T2_TABLE_B7::N, DVB_T2_TABLE_B7::K, DVB_T2_TABLE_B7::DEG, DVB_T2_TABLE_B7::LEN, DVB_T2_TABLE_B7::POS),
+		};
+		const float qef_snr[4] = { -1.8, 0.3, 2.2, 2.5 };
+		CODE::LDPCEncoder<DVB_T2_TABLE_A1> encode_a1;
+		CODE::LDPCEncoder<DVB_T2_TABLE_A3> encode_a3;
+		CODE::LDPCEncoder<DVB_T2_TABLE_A6> encode_a6;
+		CODE::LDPCEncoder<DVB_T2_TABLE_B7> encode_b7;
+		typedef CODE::LDPCRuntimeDecoder<BETA, 64800, DVB_T2_TABLE_A6::LINKS_TOTAL> RUNTIME;
+		RUNTIME *runtime = new RUNTIME();
+		// TABLE might be a short code, so we need our own buffers
+		int8_t *code = new int8_t[64800];
+		int8_t *orig = new int8_t[64800];
+		for (int frame = 0; frame < 16; ++frame) {
+			int t = frame % 4;
+			int code_len = tables[t].N, data_len = tables[t].K;
+			for (int i = 0; i < data_len; ++i)
+				code[i] = 1 - 2 * (generator() & 1);
+			switch (t) {
+			case 0: encode_a1(code, code + data_len); break;
+			case 1: encode_a3(code, code + data_len); break;
+			case 2: encode_a6(code, code + data_len); break;
+			case 3: encode_b7(code, code + data_len); break;
+			}
+			for (int i = 0; i < code_len; ++i)
+				orig[i] = code[i];
+			float SNR = qef_snr[t] + 1;
+			float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+			auto awgn = std::bind(normal(0, sigma_noise), generator);
+			float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+			for (int i = 0; i < code_len; ++i)
+				code[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (code[i] + awgn())), -127), 127);
+			int count = (*runtime)(tables + t, code, code + data_len, TRIALS);
+			assert(count >= 0);
+			for (int i = 0; i < code_len; ++i)
+				assert(code[i] * orig[i] > 0);
+		}
+		delete[] code;
+		delete[] orig;
+		delete runtime;
+	}
+	if (1) {
+		// writing straight into the native layout must give the same result as the transposing interface
+		float SNR = QEF_SNR + 0.5;
+		float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+		auto data = std::bind(uniform(0, 1), generator);
+		auto awgn = std::bind(normal(0, sigma_noise), generator);
+		float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+		for (int i = 0; i < DATA_LEN; ++i)
+			code[i] = 1 - 2 * data();
+		encode(code, code + DATA_LEN);
+		for (int i = 0; i < CODE_LEN; ++i)
+			noisy[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (code[i] + awgn())), -127), 127);
+		for (int i = 0; i < CODE_LEN; ++i)
+			code[i] = noisy[i];
+		// the write disable masks keep changing, so both need a fresh decoder
+		typedef CODE::LDPCDecoder<TABLE, BETA> DECODER;
+		DECODER *transposing = new DECODER(), *native = new DECODER();
+		int count = (*transposing)(code, code + DATA_LEN, TRIALS);
+		for (int i = 0; i < DATA_LEN; ++i)
+			native->message_at(i) = noisy[i];
+		for (int i = 0; i < CODE_LEN - DATA_LEN; ++i)
+			native->parity_at(i) = noisy[DATA_LEN + i];
+		assert(native->decode(TRIALS) == count);
+		for (int i = 0; i < DATA_LEN; ++i)
+			assert(native->message_at(i) == code[i]);
+		for (int i = 0; i < CODE_LEN - DATA_LEN; ++i)
+			assert(native->parity_at(i) == code[DATA_LEN + i]);
+		delete transposing;
+		delete native;
+	}
+	if (1) {
+		// the statistics must account for every frame, iteration and check node
+		typedef CODE::LDPCDecoder<TABLE, BETA, CODE::LDPCStats<TRIALS>> DECODER;
+		DECODER *counting = new DECODER();
+		const int FRAMES = 4;
+		for (int frame = 0; frame < FRAMES; ++frame) {
+			float SNR = QEF_SNR + 0.5 * frame;
+			float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+			auto awgn = std::bind(normal(0, sigma_noise), generator);
+			float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+			for (int i = 0; i < DATA_LEN; ++i)
+				code[i] = 1 - 2 * (generator() & 1);
+			encode(code, code + DATA_LEN);
+			for (int i = 0; i < CODE_LEN; ++i)
+				code[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (code[i] + awgn())), -127), 127);
+			(*counting)(code, code + DATA_LEN, TRIALS);
+		}
+		auto &stats = counting->stats;
+		assert(stats.frames == FRAMES);
+		uint64_t converged = 0, checked = 0, updates = 0;
+		for (int i = 0; i <= TRIALS; ++i)
+			converged += stats.iterations[i];
+		assert(converged + stats.failures == FRAMES);
+		for (int b = 0; b < stats.BINS; ++b) {
+			checked += stats.unsatisfied[0].bin[b];
+			updates += stats.saturated.bin[b];
+		}
+		// noise always leaves some check nodes unsatisfied at first
+		assert(checked == FRAMES && !stats.unsatisfied[0].bin[0]);
+		assert(updates > 0);
+		std::ostringstream histograms;
+		stats.write(histograms);
+		assert(histograms.str().find("unsatisfied 0 ") != std::string::npos);
+		delete counting;
+	}
+	if (1) {
+		// regenerating the messages from the compressed state must not change a single value
+		typedef CODE::LDPCDecoder<TABLE, BETA> DECODER;
+		typedef CODE::LDPCCompactDecoder<TABLE, BETA> COMPACT;
+		DECODER *reference = new DECODER();
+		COMPACT *compact = new COMPACT();
+		// below QEF the decoders keep going for all trials
+		const float snrs[2] = { QEF_SNR - 0.5f, QEF_SNR + 0.5f };
+		for (float SNR : snrs) {
+			float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+			auto awgn = std::bind(normal(0, sigma_noise), generator);
+			float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+			for (int i = 0; i < DATA_LEN; ++i)
+				code[i] = 1 - 2 * (generator() & 1);
+			encode(code, code + DATA_LEN);
+			for (int i = 0; i < CODE_LEN; ++i)
+				code[i] = noisy[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (code[i] + awgn())), -127), 127);
+			int count = (*reference)(code, code + DATA_LEN, TRIALS);
+			assert((*compact)(noisy, noisy + DATA_LEN, TRIALS) == count);
+			for (int i = 0; i < CODE_LEN; ++i)
+				assert(noisy[i] == code[i]);
+		}
+		delete reference;
+		delete compact;
+	}
+	if (1) {
+		// frames of different difficulty on a few threads, with less slots than frames
+		const int THREADS = 3, SLOTS = 4, FRAMES = 12;
+		typedef CODE::LDPCPipeline<TABLE, BETA> PIPELINE;
+		PIPELINE *pipeline = new PIPELINE(THREADS, SLOTS, TRIALS);
+		int8_t *codes = new int8_t[FRAMES * CODE_LEN];
+		int8_t *origs = new int8_t[FRAMES * CODE_LEN];
+		for (int n = 0; n < FRAMES; ++n) {
+			float SNR = QEF_SNR + 0.5f + 0.5f * (n % 4);
+			float sigma_noise = std::sqrt(1 / (2 * std::pow(10, SNR / 10)));
+			auto awgn = std::bind(normal(0, sigma_noise), generator);
+			float fact = 2 * FACTOR / (sigma_noise * sigma_noise);
+			int8_t *frame = codes + CODE_LEN * n;
+			for (int i = 0; i < DATA_LEN; ++i)
+				frame[i] = 1 - 2 * (generator() & 1);
+			encode(frame, frame + DATA_LEN);
+			for (int i = 0; i < CODE_LEN; ++i)
+				origs[CODE_LEN * n + i] = frame[i];
+			for (int i = 0; i < CODE_LEN; ++i)
+				frame[i] = std::min<float>(std::max<float>(std::nearbyint(fact * (frame[i] + awgn())), -127), 127);
+		}
+		int popped = 0;
+		auto check = [&]() {
+			int count;
+			int8_t *frame = pipeline->pop(&count);
+			assert(frame == codes + CODE_LEN * popped);
+			assert(count >= 0);
+			int uncorrected_errors = 0;
+			for (int i = 0; i < CODE_LEN; ++i)
+				uncorrected_errors += frame[i] * origs[CODE_LEN * popped + i] <= 0;
+			assert(uncorrected_errors <= BCH_T);
+			++popped;
+		};
+		for (int n = 0; n < FRAMES; ++n) {
+			if (pipeline->pending() == SLOTS)
+				check();
+			pipeline->push(codes + CODE_LEN * n);
+		}
+		while (popped < FRAMES)
+			check();
+		assert(!pipeline->pending());
+		delete[] codes;
+		delete[] origs;
+		delete pipeline;
+	}
+	if (1) {
+		packed_encoder_test<DVB_T2_TABLE_A1>();
+		packed_encoder_test<DVB_T2_TABLE_A3>();
+		packed_encoder_test<DVB_T2_TABLE_A6>();
+		packed_encoder_test<DVB_T2_TABLE_B7>();
+	}
+
 	delete[] code;
 	delete[] orig;
 	delete[] noisy;
 	delete[] symb;
 
-	std::cerr << "QEF at: " << min_SNR << " SNR, speed min: " << min_mbs << " Mb/s and speed max: " << max_mbs << " Mb/s." << std::endl;
-	assert(min_SNR < QEF_SNR);
 	std::cerr << "Low-density parity-check code regression test passed!" << std::endl;
 	return 0;
 }
@@ -17,6 +17,7 @@ Copyright 2025 Ahmet Inan <inan@aicodix.de>
 #include "pac_encoder.hh"
 #include "polar_sequence.hh"
 #include "crc.hh"
+#include "simd_crc.hh"
 
 int main()
 {
@@ -38,6 +39,7 @@ int main()
 #endif
 
 	typedef SIMD<code_type, L> simd_type;
+	CODE::SIMDCRC<simd_type, uint16_t> simd_crc(0xA8F4);
 
 	std::random_device rd;
 	typedef std::default_random_engine generator;
@@ -139,11 +141,9 @@ int main()
 			int best = 0;
 			if (crc_aided) {
 				bool error = true;
+				auto pass = simd_crc(decoded, K);
 				for (int k = 0; k < L; ++k) {
-					crc.reset();
-					for (int i = 0; i < K; ++i)
-						crc(decoded[i].v[k] < 0);
-					if (crc() == 0) {
+					if (pass.v[k]) {
 						best = k;
 						error = false;
 						break;
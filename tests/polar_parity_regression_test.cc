@@ -16,6 +16,7 @@ Copyright 2020 Ahmet Inan <inan@aicodix.de>
 #include "polar_sequence.hh"
 #include "polar_parity_aided.hh"
 #include "crc.hh"
+#include "simd_crc.hh"
 #include "sequence.h"
 
 bool get_bit(const uint32_t *bits, int idx)
@@ -42,6 +43,7 @@ int main()
 #endif
 
 	typedef SIMD<code_type, L> simd_type;
+	CODE::SIMDCRC<simd_type, uint32_t> simd_crc(0xD419CC15);
 
 	std::random_device rd;
 	typedef std::default_random_engine generator;
@@ -163,11 +165,9 @@ int main()
 			int best = 0;
 			if (crc_aided) {
 				bool error = true;
+				auto pass = simd_crc(decoded, K);
 				for (int k = 0; k < L; ++k) {
-					crc.reset();
-					for (int i = 0; i < K; ++i)
-						crc(decoded[i].v[k] < 0);
-					if (crc() == 0) {
+					if (pass.v[k]) {
 						best = k;
 						error = false;
 						break;
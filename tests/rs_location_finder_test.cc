@@ -0,0 +1,197 @@
+/*
+Test for the closed form root finding of error locators
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#include <random>
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include "galois_field.hh"
+#include "reed_solomon_error_correction.hh"
+
+// $locator = \prod_i(1 + x / pe^{locations_i+1})$, so location $l$ is where $locator(pe^{l+1}) = 0$
+template <typename GF>
+void build_locator(const int *locations, int degree, typename GF::ValueType *locator)
+{
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	locator[0] = ValueType(1);
+	for (int i = 0; i < degree; ++i) {
+		ValueType root(value(IndexType((locations[i] + 1) % GF::N)));
+		locator[i+1] = ValueType(0);
+		for (int j = i + 1; j > 0; --j)
+			locator[j] = locator[j-1] + locator[j] * root;
+		locator[0] *= root;
+	}
+}
+
+// the locations are distinct, so finding each of them means we got all of them in some order
+template <typename GF>
+bool same_locations(const int *locations, const typename GF::IndexType *found, int degree)
+{
+	for (int i = 0; i < degree; ++i) {
+		bool hit = false;
+		for (int j = 0; j < degree; ++j)
+			hit |= (int)found[j] == locations[i];
+		if (!hit)
+			return false;
+	}
+	return true;
+}
+
+template <int NR, typename GF>
+void check_locator(CODE::RS::LocationFinder<NR, GF> *search, const int *locations, int degree)
+{
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	ValueType locator[NR+1];
+	build_locator<GF>(locations, degree, locator);
+	IndexType found[NR], chien[NR];
+	int closed_count = (*search)(locator, degree, found);
+	assert(closed_count == degree);
+	int chien_count = CODE::RS::Chien<NR, GF>::search(locator, degree, chien);
+	assert(chien_count == degree);
+	assert(same_locations<GF>(locations, found, degree));
+	assert(same_locations<GF>(locations, chien, degree));
+}
+
+// random distinct locations, trying all choices for the last one until $zero(locator)$ holds
+template <typename GF, typename RND, typename ZERO>
+bool find_locations(RND &rnd, int *locations, int degree, ZERO zero)
+{
+	typename GF::ValueType locator[5];
+	for (int i = 0; i < degree - 1; ++i) {
+		locations[i] = rnd();
+		for (int j = 0; j < i; ++j)
+			if (locations[j] == locations[i])
+				return false;
+	}
+	for (int l = 0; l < GF::N; ++l) {
+		locations[degree-1] = l;
+		if (std::find(locations, locations + degree - 1, l) != locations + degree - 1)
+			continue;
+		build_locator<GF>(locations, degree, locator);
+		// the closed forms work on the monic locator
+		for (int i = 0; i < degree; ++i)
+			locator[i] = locator[i] / locator[degree];
+		if (zero(locator))
+			return true;
+	}
+	return false;
+}
+
+template <typename GF>
+void location_finder_test(int trials)
+{
+	typedef typename GF::ValueType ValueType;
+	typedef typename GF::IndexType IndexType;
+	const int NR = 8;
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::uniform_int_distribution<int> distribution;
+	auto rnd = std::bind(distribution(0, GF::N - 1), generator);
+	auto rnd_val = std::bind(distribution(1, GF::N), generator);
+	auto search = new CODE::RS::LocationFinder<NR, GF>();
+	int locations[4];
+	// random distinct locations
+	for (int degree = 1; degree <= 4; ++degree) {
+		for (int trial = 0; trial < trials; ++trial) {
+			for (int i = 0; i < degree; ++i) {
+				int l;
+				do l = rnd();
+				while (std::find(locations, locations + i, l) != locations + i);
+				locations[i] = l;
+			}
+			check_locator(search, locations, degree);
+		}
+	}
+	// coefficients vanishing make the closed forms take their other paths
+	std::function<bool(const ValueType *)> cubics[] = {
+		// $a = 0$, no shift needed
+		[](const ValueType *l){ return !l[2]; },
+		// $b = 0$
+		[](const ValueType *l){ return !l[1]; },
+		// $a^2 + b = 0$, the reduced cubic becomes $y^3 = q$
+		[](const ValueType *l){ return !(l[2] * l[2] + l[1]); },
+	};
+	for (auto zero: cubics) {
+		for (int trial = 0; trial < trials / 10; ++trial) {
+			if (find_locations<GF>(rnd, locations, 3, zero))
+				check_locator(search, locations, 3);
+		}
+	}
+	std::function<bool(const ValueType *)> quartics[] = {
+		// $a = 0$, no shift needed
+		[](const ValueType *l){ return !l[3]; },
+		// $b = 0$
+		[](const ValueType *l){ return !l[2]; },
+		// $c = 0$, the shift $e$ vanishes
+		[](const ValueType *l){ return !l[1]; },
+	};
+	for (auto zero: quartics) {
+		for (int trial = 0; trial < trials / 10; ++trial) {
+			if (find_locations<GF>(rnd, locations, 4, zero))
+				check_locator(search, locations, 4);
+		}
+	}
+	// $a = 0$ and $b = 0$, the resolvent cubic becomes $s^3 = c$
+	for (int trial = 0; trial < trials / 10; ++trial) {
+		if (!find_locations<GF>(rnd, locations, 3, cubics[2]))
+			continue;
+		ValueType sum(0);
+		for (int i = 0; i < 3; ++i)
+			sum += value(IndexType((locations[i] + 1) % GF::N));
+		if (!sum)
+			continue;
+		locations[3] = (int)index(sum) - 1;
+		if (locations[3] < 0)
+			locations[3] += GF::N;
+		if (std::find(locations, locations + 3, locations[3]) != locations + 3)
+			continue;
+		ValueType locator[NR+1];
+		build_locator<GF>(locations, 4, locator);
+		assert(!locator[3] && !locator[2]);
+		check_locator(search, locations, 4);
+	}
+	// random locators: when the roots are distinct and all in the field, both must find the same
+	for (int degree = 2; degree <= 4; ++degree) {
+		for (int trial = 0; trial < trials; ++trial) {
+			ValueType locator[NR+1];
+			for (int i = 0; i <= degree; ++i)
+				locator[i] = ValueType(rnd_val());
+			IndexType found[NR], chien[NR];
+			int count = CODE::RS::Chien<NR, GF>::search(locator, degree, chien);
+			int closed = (*search)(locator, degree, found);
+			if (count < degree) {
+				assert(closed < degree);
+				continue;
+			}
+			assert(closed == degree);
+			int expected[NR];
+			for (int i = 0; i < degree; ++i)
+				expected[i] = (int)chien[i];
+			assert(same_locations<GF>(expected, found, degree));
+		}
+	}
+	delete search;
+}
+
+int main()
+{
+	if (1) {
+		typedef CODE::GaloisField<8, 0b100011101, uint8_t> GF;
+		GF instance;
+		location_finder_test<GF>(10000);
+	}
+	if (1) {
+		typedef CODE::GaloisField<16, 0b10000000000101101, uint16_t> GF;
+		GF instance;
+		location_finder_test<GF>(1000);
+	}
+	std::cerr << "Reed Solomon location finder test passed!" << std::endl;
+	return 0;
+}
+
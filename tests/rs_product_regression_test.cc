@@ -0,0 +1,71 @@
+/*
+Regression Test for the Reed Solomon Product Code Encoder and Decoder
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#include <cassert>
+#include <random>
+#include <iostream>
+#include <functional>
+#include "galois_field.hh"
+#include "reed_solomon_product_encoder.hh"
+#include "reed_solomon_product_decoder.hh"
+
+int main()
+{
+	// DVD like RS(182, 172) x RS(208, 192) product code
+	typedef CODE::GaloisField<8, 0b100011101, uint8_t> GF;
+	GF instance;
+	const int ROW_DATA = 172, COL_DATA = 192;
+	typedef CODE::ReedSolomonProductEncoder<10, 16, 0, GF> ENC;
+	typedef CODE::ReedSolomonProductDecoder<10, 16, 0, GF> DEC;
+	const int COLS = ROW_DATA + ENC::ROW_NP, ROWS = COL_DATA + ENC::COL_NP;
+	ENC *encode = new ENC();
+	DEC *decode = new DEC();
+	// pools of one to four threads, started once for all trials
+	CODE::ParallelPool *pools[4];
+	for (int t = 0; t < 4; ++t)
+		pools[t] = new CODE::ParallelPool(t + 1);
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::uniform_int_distribution<int> distribution;
+	auto rnd_val = std::bind(distribution(0, GF::N), generator);
+	auto rnd_row = std::bind(distribution(0, ROWS - 1), generator);
+	auto rnd_col = std::bind(distribution(0, COLS - 1), generator);
+	auto rnd_len = std::bind(distribution(1, 3 * COLS), generator);
+	uint8_t *block = new uint8_t[ROWS * COLS];
+	uint8_t *orig = new uint8_t[ROWS * COLS];
+	for (int trial = 0; trial < 100; ++trial) {
+		for (int r = 0; r < COL_DATA; ++r)
+			for (int c = 0; c < ROW_DATA; ++c)
+				block[r * COLS + c] = rnd_val();
+		(*encode)(block, ROW_DATA, COL_DATA, pools[3]);
+		for (int i = 0; i < ROWS * COLS; ++i)
+			orig[i] = block[i];
+		int ret = (*decode)(block, ROW_DATA, COL_DATA, 4, pools[3]);
+		assert(ret == 0);
+		// a few bursts wiping out whole rows, beyond what the row code can correct
+		for (int burst = 0; burst < 4; ++burst) {
+			int pos = rnd_row() * COLS + rnd_col(), len = rnd_len();
+			for (int i = pos; i < pos + len && i < ROWS * COLS; ++i)
+				block[i] = rnd_val();
+		}
+		// and some scattered symbol errors
+		for (int i = 0; i < 100; ++i)
+			block[rnd_row() * COLS + rnd_col()] = rnd_val();
+		ret = (*decode)(block, ROW_DATA, COL_DATA, 4, trial % 5 ? pools[trial % 5 - 1] : 0);
+		assert(ret > 0);
+		for (int i = 0; i < ROWS * COLS; ++i)
+			assert(block[i] == orig[i]);
+	}
+	delete[] block;
+	delete[] orig;
+	for (int t = 0; t < 4; ++t)
+		delete pools[t];
+	delete encode;
+	delete decode;
+	std::cerr << "Reed Solomon product code regression test passed!" << std::endl;
+	return 0;
+}
+
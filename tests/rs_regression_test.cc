@@ -76,6 +76,141 @@ void rs_test(ENC *encode, DEC *decode, int trials)
 	}
 }
 
+template <typename ENC, typename DEC>
+void rs_batch_test(ENC *encode, DEC *decode, int trials)
+{
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::uniform_int_distribution<typename ENC::value_type> distribution;
+	auto rnd_cnt = std::bind(distribution(0, ENC::NR), generator);
+	auto rnd_len = std::bind(distribution(1, ENC::K), generator);
+	auto rnd_val = std::bind(distribution(0, ENC::N), generator);
+	const int BLOCKS = 16;
+	// too big for the stack with RS(65535)
+	typedef typename ENC::value_type value_type;
+	value_type *data = new value_type[BLOCKS*ENC::K], *orig_data = new value_type[BLOCKS*ENC::K];
+	value_type *parity = new value_type[BLOCKS*ENC::NP], *orig_parity = new value_type[BLOCKS*ENC::NP];
+	while (--trials) {
+		int data_len = rnd_len();
+		auto rnd_pos = std::bind(distribution(0, data_len + ENC::NP - 1), generator);
+		int erasures_count = rnd_cnt();
+		typename ENC::value_type erasures[ENC::NR];
+		for (int i = 0; i < erasures_count; ++i) {
+			int pos = rnd_pos();
+			for (int j = 0; j < i; ++j) {
+				if (erasures[j] == pos) {
+					pos = rnd_pos();
+					j = -1;
+				}
+			}
+			erasures[i] = pos;
+		}
+		for (int b = 0; b < BLOCKS; ++b) {
+			typename ENC::value_type *d = data + b * data_len, *p = parity + b * ENC::NP;
+			for (int i = 0; i < data_len; ++i)
+				d[i] = orig_data[b*data_len+i] = rnd_val();
+			(*encode)(d, p, data_len);
+			for (int i = 0; i < ENC::NP; ++i)
+				orig_parity[b*ENC::NP+i] = p[i];
+			for (int i = 0; i < erasures_count; ++i) {
+				int pos = erasures[i];
+				if (pos < data_len)
+					d[pos] = rnd_val();
+				else
+					p[pos-data_len] = rnd_val();
+			}
+			// every other block gets additional errors on top of the shared erasures
+			int error_count = b & 1 ? (ENC::NR - erasures_count) / 2 : 0;
+			for (int i = 0; i < error_count; ++i) {
+				int pos = rnd_pos();
+				if (pos < data_len)
+					d[pos] = rnd_val();
+				else
+					p[pos-data_len] = rnd_val();
+			}
+		}
+		int results[BLOCKS];
+		int failures = decode->batch(data, parity, BLOCKS, erasures, erasures_count, results, data_len);
+		assert(!failures);
+		for (int b = 0; b < BLOCKS; ++b)
+			assert(results[b] >= 0);
+		for (int i = 0; i < BLOCKS * data_len; ++i)
+			assert(data[i] == orig_data[i]);
+		for (int i = 0; i < BLOCKS * ENC::NP; ++i)
+			assert(parity[i] == orig_parity[i]);
+	}
+	delete[] data;
+	delete[] orig_data;
+	delete[] parity;
+	delete[] orig_parity;
+}
+
+// compare the table driven encoder and the blocked syndromes to polynomial division and Horner's method
+template <int FCR, typename ENC, typename DEC>
+void rs_reference_test(ENC *encode, DEC *decode, int trials)
+{
+	typedef typename ENC::ValueType ValueType;
+	typedef typename ENC::IndexType IndexType;
+	const int NR = ENC::NR, NP = ENC::NP, K = ENC::K;
+	std::random_device rd;
+	std::default_random_engine generator(rd());
+	typedef std::uniform_int_distribution<typename ENC::value_type> distribution;
+	auto rnd_len = std::bind(distribution(1, K), generator);
+	auto rnd_val = std::bind(distribution(0, ENC::N), generator);
+	// $generator = \prod_{i=0}^{NR}(x-pe^{FCR+i})$
+	ValueType gen[NR+1];
+	IndexType root(FCR), pe(1);
+	for (int i = 0; i < NR; ++i) {
+		gen[i] = ValueType(1);
+		for (int j = i; j > 0; --j)
+			gen[j] = fma(root, gen[j], gen[j-1]);
+		gen[0] *= root;
+		root *= pe;
+	}
+	gen[NR] = ValueType(1);
+	ValueType *data = new ValueType[K];
+	ValueType parity[NP], expected_parity[NP];
+	ValueType syndromes[NR], expected_syndromes[NR];
+	// none of these are multiples of the block size
+	int lengths[] = { 1, 2, 63, 65, 1000, 4097, K };
+	for (int t = 0; t < trials; ++t) {
+		int data_len = t < int(sizeof(lengths) / sizeof(*lengths)) ? lengths[t] : rnd_len();
+		if ((data_len + NP) % 64 == 0)
+			continue;
+		for (int i = 0; i < data_len; ++i)
+			data[i] = ValueType(rnd_val());
+		(*encode)(data, parity, data_len);
+		for (int i = 0; i < NP; ++i)
+			expected_parity[i] = ValueType(0);
+		for (int i = 0; i < data_len; ++i) {
+			ValueType feedback = data[i] + expected_parity[0];
+			for (int j = 1; j < NP; ++j)
+				expected_parity[j-1] = expected_parity[j] + feedback * gen[NR-j];
+			expected_parity[NP-1] = feedback * gen[0];
+		}
+		for (int i = 0; i < NP; ++i)
+			assert(parity[i] == expected_parity[i]);
+		assert(!decode->compute_syndromes(data, parity, syndromes, data_len));
+		// garble the parity, so we get non-zero syndromes
+		for (int i = 0; i < NP; ++i)
+			parity[i] = ValueType(rnd_val());
+		decode->compute_syndromes(data, parity, syndromes, data_len);
+		// $syndromes_i = code(pe^{FCR+i})$
+		for (int i = 0; i < NR; ++i) {
+			IndexType x(FCR + i);
+			ValueType sum(data[0]);
+			for (int j = 1; j < data_len; ++j)
+				sum = fma(x, sum, data[j]);
+			for (int j = 0; j < NP; ++j)
+				sum = fma(x, sum, parity[j]);
+			expected_syndromes[i] = sum;
+		}
+		for (int i = 0; i < NR; ++i)
+			assert(syndromes[i] == expected_syndromes[i]);
+	}
+	delete[] data;
+}
+
 int main()
 {
 	if (1) {
@@ -85,6 +220,7 @@ int main()
 		CODE::ReedSolomonEncoder<4, 0, GF> encoder;
 		CODE::ReedSolomonDecoder<4, 0, GF> decoder;
 		rs_test(&encoder, &decoder, 1000000);
+		rs_batch_test(&encoder, &decoder, 100000);
 	}
 	if (1) {
 		// DVB-T RS(255, 239) T=8
@@ -93,6 +229,15 @@ int main()
 		CODE::ReedSolomonEncoder<16, 0, GF> encoder;
 		CODE::ReedSolomonDecoder<16, 0, GF> decoder;
 		rs_test(&encoder, &decoder, 100000);
+		rs_batch_test(&encoder, &decoder, 10000);
+	}
+	if (1) {
+		// DVB-T RS(255, 239) T=8
+		typedef CODE::GaloisField<8, 0b100011101, uint8_t> GF;
+		GF instance;
+		CODE::ReedSolomonEncoder<16, 0, GF> encoder;
+		CODE::ReedSolomonDecoder<16, 0, GF, CODE::RS::InversionlessBerlekampMassey> decoder;
+		rs_test(&encoder, &decoder, 100000);
 	}
 	if (1) {
 		// FUN RS(65535, 65471) T=32
@@ -101,6 +246,8 @@ int main()
 		CODE::ReedSolomonEncoder<64, 1, GF> encoder;
 		CODE::ReedSolomonDecoder<64, 1, GF> decoder;
 		rs_test(&encoder, &decoder, 100);
+		rs_batch_test(&encoder, &decoder, 10);
+		rs_reference_test<1>(&encoder, &decoder, 20);
 	}
 	std::cerr << "Reed Solomon regression test passed!" << std::endl;
 	return 0;
@@ -0,0 +1,65 @@
+/*
+Test for the Monte Carlo simulation harness
+
+Copyright 2026 Ahmet Inan <inan@aicodix.de>
+*/
+
+#include <cassert>
+#include <sstream>
+#include <iostream>
+#include "simulation.hh"
+
+// uncoded BPSK, so we know what to expect
+struct Uncoded
+{
+	static const int BITS = 1000;
+	int8_t bpsk[BITS], llr[BITS];
+	int bits()
+	{
+		return BITS;
+	}
+	int operator()(CODE::SimulationRNG &rng, float snr)
+	{
+		for (int i = 0; i < BITS; ++i)
+			bpsk[i] = 1 - 2 * (rng() & 1);
+		CODE::simulation_awgn(rng, snr, bpsk, llr, BITS);
+		int errors = 0;
+		// erasures are a coin toss
+		for (int i = 0; i < BITS; ++i)
+			errors += llr[i] * bpsk[i] < 0 || (!llr[i] && (rng() & 1));
+		return errors;
+	}
+};
+
+int main()
+{
+	// the same frames no matter how many threads
+	CODE::Simulation<Uncoded> single(1, 12345, 1000, 20), triple(3, 12345, 1000, 20, 5);
+	for (float snr : { 2.f, 6.f }) {
+		auto a = single(snr), b = triple(snr);
+		assert(a.frames == b.frames && a.frame_errors == b.frame_errors && a.bit_errors == b.bit_errors);
+		assert(a.frame_errors == 20 || a.frames == 1000);
+		assert(a.bits == a.frames * Uncoded::BITS);
+	}
+	// a different seed gives different frames
+	CODE::Simulation<Uncoded> other(2, 54321, 1000, 20);
+	auto x = other(6), y = single(6);
+	assert(x.frames != y.frames || x.bit_errors != y.bit_errors);
+	// $BER = \frac{1}{2} erfc(\sqrt{E_s/N_0})$
+	CODE::Simulation<Uncoded> simulate(2, 1, 100000, 100);
+	auto points = simulate.sweep(0, 6, 2);
+	assert(points.size() == 4);
+	for (auto &p : points) {
+		double expected = 0.5 * std::erfc(std::sqrt(std::pow(10, p.snr / 10)));
+		assert(p.frame_errors == 100);
+		assert(std::abs(p.ber() - expected) < 0.1 * expected);
+	}
+	std::ostringstream csv, json;
+	CODE::simulation_csv(csv, points);
+	CODE::simulation_json(json, points);
+	assert(csv.str().find("snr,frames,frame_errors,bits,bit_errors,fer,ber,seconds\n0,100,100,100000,") == 0);
+	assert(json.str().find("{\"snr\": 6, ") != std::string::npos);
+	std::cerr << "Simulation test passed!" << std::endl;
+	return 0;
+}
+